@@ -0,0 +1,407 @@
+//
+//  biconnected.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Параллельное вычисление мостов, шарниров, двусвязных и реберно-двусвязных компонент неориентированного графа.
+// Дерево блоков и шарниров (block-cut tree) для ответа на вопрос "разделяет ли шарнир x вершины a и b".
+
+#ifndef biconnected_h
+#define biconnected_h
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include "graphBase.h"
+#include "disjointSet.h"
+#include "parallel.h"
+#include "parallelCC.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Двусвязность. Алгоритм Тарьяна-Вишкина. Tarjan, Vishkin "An efficient parallel biconnectivity algorithm". 1985.
+    // Вместо DFS (Bridges_T, ArtPoint_T) используется произвольный остовный лес, который строится параллельным BFS.
+    // Для вершин остовного леса вычисляются прямой номер pre[v], размер поддерева nd[v] и
+    // low[v]/high[v] - наименьший/наибольший pre, достижимый из поддерева v по одному недревесному ребру.
+    // Все вычисления выполняются параллельно по уровням остовного леса.
+    // - Древесное ребро (p, v) - мост, если из поддерева v нет недревесных рёбер наружу.
+    // - Блоки (двусвязные компоненты) - классы эквивалентности древесных рёбер:
+    //   1. рёбра (p(u), u) и (p(w), w) эквивалентны, если u и w соединены недревесным ребром и не являются предком друг друга.
+    //   2. рёбра (p(w), w) и (w, v) эквивалентны, если w не корень и из поддерева v есть недревесное ребро за поддерево w.
+    //   Недревесное ребро {u, w}, pre[u] > pre[w], принадлежит блоку ребра (p(u), u).
+    // - Реберно-двусвязные компоненты - компоненты остовного леса без мостов.
+    // Древесное ребро (p(v), v) везде обозначается вершиной v.
+    // O(V + E) работы, O(D) параллельных шагов, D - глубина остовного леса.
+    template <class G> class Biconnected_T {
+        static_assert(!G::Traits::directed, "Biconnected_T requires undirected graph");
+        using Edge = typename G::Edge;
+
+        vector<size_t> _parent; // родители вершин в остовном лесе, -1 - корень.
+        vector<size_t> _pre; // прямой номер вершины в остовном лесе.
+        vector<size_t> _nd; // количество вершин в поддереве.
+        vector<size_t> _low, _high; // наименьший/наибольший pre, достижимый из поддерева по недревесному ребру.
+        vector<size_t> _childStart, _children; // списки детей в остовном лесе.
+        vector<vector<size_t>> _levels; // вершины остовного леса по уровням.
+        vector<size_t> _block; // номер блока древесного ребра (p(v), v).
+        size_t _blocks = 0;
+        vector<char> _cut; // является ли вершина шарниром.
+        vector<size_t> _twoEdge; // номер реберно-двусвязной компоненты вершины.
+        size_t _twoEdges = 0;
+        vector<Edge> _bridges;
+
+        bool ancestor_(size_t a, size_t b) const { return _pre[a] <= _pre[b] && _pre[b] < _pre[a] + _nd[a]; }
+        bool bridge_(size_t v) const { return _low[v] >= _pre[v] && _high[v] < _pre[v] + _nd[v]; }
+        bool treeEdge_(size_t v, size_t w) const { return _parent[v] == w || _parent[w] == v; }
+
+        // Остовный лес параллельным BFS одновременно из наименьших вершин всех компонент связности.
+        void spanningForest_(const G& g) {
+            auto cc = CCAfforest(g);
+            vector<size_t> roots;
+            roots.reserve(cc.size());
+            for (size_t v = 0; v < g.size(); v++) {
+                if (cc.id(v) == roots.size()) roots.push_back(v);
+            }
+
+            vector<atomic<size_t>> parent(g.size());
+            parallelFor(0, g.size(), [&](size_t v) { parent[v].store(-1, memory_order_relaxed); });
+            for (size_t r : roots) parent[r].store(r, memory_order_relaxed);
+
+            vector<vector<size_t>> next(threadsCount());
+            for (vector<size_t> frontier = roots; !frontier.empty(); ) {
+                for (auto& n : next) n.clear();
+                parallelForT(0, frontier.size(), [&](size_t i, size_t t) {
+                    size_t v = frontier[i];
+                    for (size_t w : g.adjacent(v)) {
+                        size_t expected = -1;
+                        if (parent[w].load(memory_order_relaxed) == expected &&
+                            parent[w].compare_exchange_strong(expected, v, memory_order_relaxed)) {
+                            next[t].push_back(w);
+                        }
+                    }
+                }, 64);
+                _levels.push_back(move(frontier));
+                frontier.clear();
+                for (auto& n : next) frontier.insert(frontier.end(), n.begin(), n.end());
+            }
+
+            parallelFor(0, g.size(), [&](size_t v) {
+                size_t p = parent[v].load(memory_order_relaxed);
+                _parent[v] = p == v ? -1 : p;
+            });
+        }
+
+        // Списки детей, размеры поддеревьев и прямые номера.
+        void numbering_() {
+            const size_t n = _parent.size();
+            _childStart.assign(n + 1, 0);
+            for (size_t v = 0; v < n; v++) {
+                if (_parent[v] != -1) _childStart[_parent[v] + 1]++;
+            }
+            for (size_t v = 0; v < n; v++) _childStart[v + 1] += _childStart[v];
+            _children.resize(_childStart[n]);
+            vector<size_t> pos(_childStart.begin(), _childStart.end() - 1);
+            for (size_t v = 0; v < n; v++) {
+                if (_parent[v] != -1) _children[pos[_parent[v]]++] = v;
+            }
+
+            // Размеры поддеревьев снизу вверх.
+            for (size_t l = _levels.size(); l-- > 0; ) {
+                const auto& level = _levels[l];
+                parallelFor(0, level.size(), [&](size_t i) {
+                    size_t v = level[i];
+                    size_t nd = 1;
+                    for (size_t c = _childStart[v]; c < _childStart[v + 1]; c++) nd += _nd[_children[c]];
+                    _nd[v] = nd;
+                });
+            }
+
+            // Прямые номера сверху вниз. Корни нумеруем подряд.
+            size_t offset = 0;
+            if (!_levels.empty()) {
+                for (size_t r : _levels[0]) {
+                    _pre[r] = offset;
+                    offset += _nd[r];
+                }
+            }
+            for (const auto& level : _levels) {
+                parallelFor(0, level.size(), [&](size_t i) {
+                    size_t v = level[i];
+                    size_t next = _pre[v] + 1;
+                    for (size_t c = _childStart[v]; c < _childStart[v + 1]; c++) {
+                        _pre[_children[c]] = next;
+                        next += _nd[_children[c]];
+                    }
+                });
+            }
+        }
+
+        // low и high снизу вверх.
+        void lowHigh_(const G& g) {
+            parallelFor(0, g.size(), [&](size_t v) {
+                size_t low = _pre[v], high = _pre[v];
+                for (size_t w : g.adjacent(v)) {
+                    if (treeEdge_(v, w)) continue;
+                    low = min(low, _pre[w]);
+                    high = max(high, _pre[w]);
+                }
+                _low[v] = low;
+                _high[v] = high;
+            });
+            for (size_t l = _levels.size(); l-- > 0; ) {
+                const auto& level = _levels[l];
+                parallelFor(0, level.size(), [&](size_t i) {
+                    size_t v = level[i];
+                    for (size_t c = _childStart[v]; c < _childStart[v + 1]; c++) {
+                        _low[v] = min(_low[v], _low[_children[c]]);
+                        _high[v] = max(_high[v], _high[_children[c]]);
+                    }
+                });
+            }
+        }
+
+        // Блоки - компоненты связности вспомогательного графа на древесных рёбрах.
+        void blocks_(const G& g) {
+            ConcurrentDisjointSet ds(g.size());
+            parallelFor(0, g.size(), [&](size_t v) {
+                size_t p = _parent[v];
+                if (p == -1) return;
+                // Правило 1. Каждое недревесное ребро рассматриваем один раз со стороны большего pre.
+                for (size_t w : g.adjacent(v)) {
+                    if (_pre[w] < _pre[v] && !treeEdge_(v, w) && !ancestor_(w, v)) {
+                        ds.uniteIfNotConnected(v, w);
+                    }
+                }
+                // Правило 2.
+                if (_parent[p] != -1 && (_low[v] < _pre[p] || _high[v] >= _pre[p] + _nd[p])) {
+                    ds.uniteIfNotConnected(v, p);
+                }
+            });
+
+            // Представитель - наименьший элемент множества, поэтому он перенумерован раньше остальных.
+            for (size_t v = 0; v < g.size(); v++) {
+                if (_parent[v] == -1) continue;
+                size_t r = ds.find(v);
+                _block[v] = r == v ? _blocks++ : _block[r];
+            }
+
+            // Шарнир - вершина, инцидентные древесные рёбра которой лежат в разных блоках.
+            parallelFor(0, g.size(), [&](size_t v) {
+                size_t b = _parent[v] != -1 ? _block[v] : -1;
+                for (size_t c = _childStart[v]; c < _childStart[v + 1]; c++) {
+                    size_t bc = _block[_children[c]];
+                    if (b == -1) b = bc;
+                    else if (b != bc) {
+                        _cut[v] = true;
+                        break;
+                    }
+                }
+            });
+        }
+
+        // Мосты и реберно-двусвязные компоненты.
+        void bridges_() {
+            const size_t n = _parent.size();
+            vector<size_t> head(n);
+            for (const auto& level : _levels) {
+                parallelFor(0, level.size(), [&](size_t i) {
+                    size_t v = level[i];
+                    size_t p = _parent[v];
+                    head[v] = p == -1 || bridge_(v) ? v : head[p];
+                });
+            }
+            for (size_t v = 0; v < n; v++) {
+                if (head[v] == v) {
+                    _twoEdge[v] = _twoEdges++;
+                    if (_parent[v] != -1) _bridges.push_back(Edge(_parent[v], v));
+                }
+            }
+            parallelFor(0, n, [&](size_t v) { _twoEdge[v] = _twoEdge[head[v]]; });
+        }
+
+    public:
+        Biconnected_T(const G& g) : _parent(g.size()), _pre(g.size()), _nd(g.size()), _low(g.size()), _high(g.size()),
+            _block(g.size(), -1), _cut(g.size()), _twoEdge(g.size())
+        {
+            trace("Biconnected_T");
+            prepareForParallel(g);
+            spanningForest_(g);
+            numbering_();
+            lowHigh_(g);
+            blocks_(g);
+            bridges_();
+        }
+
+        size_t size() const { return _parent.size(); }
+
+        // Мосты.
+        const vector<Edge>& bridges() const { return _bridges; }
+        bool bridge(size_t v, size_t w) const {
+            if (_parent[w] == v) return bridge_(w);
+            if (_parent[v] == w) return bridge_(v);
+            return false;
+        }
+
+        // Шарниры.
+        bool artPoint(size_t v) const { return _cut[v]; }
+        vector<size_t> artPoints() const {
+            vector<size_t> a;
+            for (size_t v = 0; v < _cut.size(); v++) if (_cut[v]) a.push_back(v);
+            return a;
+        }
+
+        // Двусвязные компоненты (блоки). Номер блока ребра {v, w}.
+        size_t blocks() const { return _blocks; }
+        size_t block(size_t v, size_t w) const {
+            if (_parent[w] == v) return _block[w];
+            if (_parent[v] == w) return _block[v];
+            return _pre[v] > _pre[w] ? _block[v] : _block[w];
+        }
+
+        // Реберно-двусвязные компоненты.
+        size_t twoEdgeComponents() const { return _twoEdges; }
+        size_t twoEdgeId(size_t v) const { return _twoEdge[v]; }
+        bool twoEdgeConnected(size_t v, size_t w) const { return _twoEdge[v] == _twoEdge[w]; }
+
+        // Остовный лес.
+        size_t parent(size_t v) const { return _parent[v]; }
+        const vector<size_t>& children() const { return _children; }
+        size_t childBegin(size_t v) const { return _childStart[v]; }
+        size_t childEnd(size_t v) const { return _childStart[v + 1]; }
+
+        // Блок, которому принадлежит вершина, не являющаяся шарниром. -1 для изолированной вершины.
+        size_t vertexBlock(size_t v) const {
+            if (_parent[v] != -1) return _block[v];
+            return _childStart[v] != _childStart[v + 1] ? _block[_children[_childStart[v]]] : -1;
+        }
+    };
+
+    // Ускоритель вызова.
+    template <class G>
+    Biconnected_T<G> biconnected(const G& g) { return Biconnected_T<G>(g); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Дерево блоков и шарниров (block-cut tree). Узлы - блоки [0, B) и шарниры [B, B + C).
+    // Шарнир соединён с каждым блоком, которому принадлежит.
+    // Удаление x разделяет a и b тогда и только тогда, когда x шарнир и его узел лежит на пути между узлами a и b.
+    // Путь проверяется через LCA на разреженной таблице по эйлерову обходу. Построение O(V + E + B*lg(B)), запрос O(1).
+    template <class G> class BlockCutTree_T {
+        size_t _blocks; // количество блоков. Узлы с номерами >= _blocks - шарниры.
+        vector<size_t> _node; // узел дерева для вершины графа. -1 для изолированной вершины.
+        vector<size_t> _tree; // номер дерева в лесе блоков и шарниров для узла.
+        vector<size_t> _tin, _tout; // время входа и выхода узла при обходе.
+        vector<size_t> _first; // первое вхождение узла в эйлеров обход.
+        vector<size_t> _depth;
+        vector<vector<size_t>> _sparse; // _sparse[k][i] - узел наименьшей глубины на отрезке эйлерова обхода [i, i + 2^k).
+
+        bool ancestor_(size_t a, size_t b) const { return _tin[a] <= _tin[b] && _tout[b] <= _tout[a]; }
+
+        size_t shallower_(size_t a, size_t b) const { return _depth[a] <= _depth[b] ? a : b; }
+
+        size_t lca_(size_t a, size_t b) const {
+            size_t l = _first[a], r = _first[b];
+            if (l > r) swap(l, r);
+            const size_t k = 63 - __builtin_clzll((unsigned long long)(r - l + 1)); // floor(lg(длины отрезка)).
+            return shallower_(_sparse[k][l], _sparse[k][r + 1 - (size_t(1) << k)]);
+        }
+
+    public:
+        BlockCutTree_T(const Biconnected_T<G>& bc) : _blocks(bc.blocks()), _node(bc.size(), -1) {
+            trace("BlockCutTree_T");
+            size_t nodes = _blocks;
+            for (size_t v = 0; v < bc.size(); v++) {
+                _node[v] = bc.artPoint(v) ? nodes++ : bc.vertexBlock(v);
+            }
+
+            // Рёбра дерева: шарнир - блоки его инцидентных древесных рёбер.
+            vector<vector<size_t>> adj(nodes);
+            for (size_t v = 0; v < bc.size(); v++) {
+                if (!bc.artPoint(v)) continue;
+                vector<size_t> bs;
+                if (bc.parent(v) != -1) bs.push_back(bc.block(bc.parent(v), v));
+                for (size_t c = bc.childBegin(v); c < bc.childEnd(v); c++) bs.push_back(bc.block(v, bc.children()[c]));
+                sort(bs.begin(), bs.end());
+                bs.erase(unique(bs.begin(), bs.end()), bs.end());
+                for (size_t b : bs) {
+                    adj[_node[v]].push_back(b);
+                    adj[b].push_back(_node[v]);
+                }
+            }
+
+            // Итеративный DFS с эйлеровым обходом.
+            _tree.assign(nodes, -1);
+            _tin.resize(nodes);
+            _tout.resize(nodes);
+            _first.resize(nodes);
+            _depth.resize(nodes);
+            vector<size_t> euler;
+            euler.reserve(2 * nodes);
+            vector<pair<size_t, size_t>> st; // узел, позиция в списке смежности.
+            size_t time = 0, trees = 0;
+            for (size_t r = 0; r < nodes; r++) {
+                if (_tree[r] != -1) continue;
+                _tree[r] = trees++;
+                _depth[r] = 0;
+                _tin[r] = time++;
+                _first[r] = euler.size();
+                euler.push_back(r);
+                st.push_back({r, 0});
+                while (!st.empty()) {
+                    size_t x = st.back().first;
+                    size_t& i = st.back().second;
+                    if (i < adj[x].size()) {
+                        size_t y = adj[x][i++];
+                        if (_tree[y] != -1) continue;
+                        _tree[y] = _tree[r];
+                        _depth[y] = _depth[x] + 1;
+                        _tin[y] = time++;
+                        _first[y] = euler.size();
+                        euler.push_back(y);
+                        st.push_back({y, 0});
+                    } else {
+                        _tout[x] = time++;
+                        st.pop_back();
+                        if (!st.empty()) euler.push_back(st.back().first);
+                    }
+                }
+            }
+
+            // Разреженная таблица.
+            _sparse.push_back(euler);
+            for (size_t k = 1; (size_t(1) << k) <= euler.size(); k++) {
+                const auto& prev = _sparse[k - 1];
+                vector<size_t> cur(euler.size() - (size_t(1) << k) + 1);
+                for (size_t i = 0; i < cur.size(); i++) {
+                    cur[i] = shallower_(prev[i], prev[i + (size_t(1) << (k - 1))]);
+                }
+                _sparse.push_back(move(cur));
+            }
+        }
+
+        // Связаны ли a и b в исходном графе.
+        bool connected(size_t a, size_t b) const {
+            if (a == b) return true;
+            if (_node[a] == -1 || _node[b] == -1) return false;
+            return _tree[_node[a]] == _tree[_node[b]];
+        }
+
+        // Разъединит ли удаление вершины x связанные вершины a и b. a, b != x.
+        bool separates(size_t x, size_t a, size_t b) const {
+            assert(x != a && x != b);
+            if (a == b || !connected(a, b)) return false;
+            size_t c = _node[x], na = _node[a], nb = _node[b];
+            // Удаление вершины, не являющейся шарниром, не нарушает связность.
+            if (c == -1 || c < _blocks || _tree[c] != _tree[na]) return false;
+            return ancestor_(lca_(na, nb), c) && (ancestor_(c, na) || ancestor_(c, nb));
+        }
+    };
+
+    // Ускоритель вызова.
+    template <class G>
+    BlockCutTree_T<G> blockCutTree(const Biconnected_T<G>& bc) { return BlockCutTree_T<G>(bc); }
+}
+
+#endif /* biconnected_h */
@@ -0,0 +1,179 @@
+//
+//  bitMatrix.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Упакованная битовая матрица для алгоритмов достижимости.
+
+#ifndef bitMatrix_h
+#define bitMatrix_h
+
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include <cassert>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "graphBase.h"
+#include "parallel.h"
+
+namespace Graph {
+
+    // Битовая матрица h x w. Строка - непрерывный массив 64-битных слов, поэтому операции над множествами
+    // (строками) идут по 64 бита за инструкцию, а с AVX2/AVX-512 - по 256/512.
+    // Длина строки в словах кратна 8: строки выровнены по 64 байта относительно начала и векторные циклы без хвостов.
+    // В отличие от matrix<bool> на vector<bool> нет прокси-объектов и побитового доступа в циклах.
+    class BitMatrix {
+    public:
+        using Word = uint64_t;
+        static constexpr size_t WORD_BITS = 64;
+
+    private:
+        size_t _h, _w;
+        size_t _stride; // Слов в строке.
+        vector<Word> _bits;
+
+    public:
+        BitMatrix(size_t h = 0, size_t w = 0) : _h(h), _w(w), _stride(((w + WORD_BITS - 1) / WORD_BITS + 7) & ~size_t(7)),
+            _bits(h * _stride) {}
+
+        // Матрица смежности графа g.
+        template<class G, class = typename G::Traits> explicit BitMatrix(const G& g) : BitMatrix(g.size(), g.size()) {
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) set(v, w);
+            }
+        }
+
+        size_t h() const { return _h; }
+        size_t w() const { return _w; }
+        // Слов в строке.
+        size_t stride() const { return _stride; }
+
+        bool test(size_t r, size_t c) const { return (_bits[r * _stride + c / WORD_BITS] >> (c % WORD_BITS)) & 1; }
+        void set(size_t r, size_t c) { _bits[r * _stride + c / WORD_BITS] |= Word(1) << (c % WORD_BITS); }
+        void reset(size_t r, size_t c) { _bits[r * _stride + c / WORD_BITS] &= ~(Word(1) << (c % WORD_BITS)); }
+
+        Word* row(size_t r) { return _bits.data() + r * _stride; }
+        const Word* row(size_t r) const { return _bits.data() + r * _stride; }
+
+        // dst |= src для n слов.
+        static void orWords(Word* dst, const Word* src, size_t n) {
+            size_t i = 0;
+#if defined(__AVX512F__)
+            for (; i + 8 <= n; i += 8) {
+                __m512i a = _mm512_loadu_si512(dst + i);
+                __m512i b = _mm512_loadu_si512(src + i);
+                _mm512_storeu_si512(dst + i, _mm512_or_si512(a, b));
+            }
+#elif defined(__AVX2__)
+            for (; i + 4 <= n; i += 4) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+            }
+#endif
+            for (; i < n; i++) dst[i] |= src[i];
+        }
+
+        // Строка dst |= строка src.
+        void orRow(size_t dst, size_t src) { orWords(row(dst), row(src), _stride); }
+
+        // Количество единиц в строке r.
+        size_t rowCount(size_t r) const {
+            size_t c = 0;
+            for (const Word* p = row(r), *e = p + _stride; p != e; ++p) c += __builtin_popcountll(*p);
+            return c;
+        }
+
+        // Количество единиц.
+        size_t count() const {
+            size_t c = 0;
+            for (size_t r = 0; r < _h; r++) c += rowCount(r);
+            return c;
+        }
+
+        // f(c) для всех единиц строки r по возрастанию c.
+        template <class F> void forEach(size_t r, F&& f) const {
+            const Word* p = row(r);
+            for (size_t i = 0; i < _stride; i++) {
+                for (Word x = p[i]; x != 0; x &= x - 1) f(i * WORD_BITS + __builtin_ctzll(x));
+            }
+        }
+
+        // Граф с матрицей смежности - этой матрицей.
+        template <class G> G toGraph() const {
+            G g(_h);
+            for (size_t r = 0; r < _h; r++) {
+                forEach(r, [&](size_t c) { g.insert({r, c}); });
+            }
+            return g;
+        }
+
+        // Занимаемая память в байтах.
+        size_t memory() const { return _bits.capacity() * sizeof(Word); }
+
+        bool operator==(const BitMatrix& m) const { return _h == m._h && _w == m._w && _bits == m._bits; }
+        bool operator!=(const BitMatrix& m) const { return !(*this == m); }
+
+        // Булево произведение a * b. Метод четырёх русских (Арлазаров, Диниц, Кронрод, Фараджев 1970).
+        // Столбцы a делятся на группы по 8. Для группы строятся все 256 объединений соответствующих 8 строк b,
+        // после чего вклад группы в строку результата - одно объединение строк по байту строки a.
+        // Если единиц в группе мало, таблица не строится и строки b объединяются напрямую.
+        // O(n^3/(8*64)) слов. Строки результата делятся на порции между потоками, таблицы у каждого потока свои.
+        friend BitMatrix operator * (const BitMatrix& a, const BitMatrix& b) {
+            assert(a._w == b._h);
+            BitMatrix c(a._h, b._w);
+            const size_t groups = (a._w + 7) / 8;
+            const size_t chunk = 512; // Строк результата на одну таблицу группы.
+            vector<vector<Word>> tables(threadsCount());
+            parallelForT(0, (a._h + chunk - 1) / chunk, [&](size_t ci, size_t t) {
+                vector<Word>& table = tables[t];
+                table.resize(256 * b._stride);
+                const size_t r0 = ci * chunk, r1 = min(a._h, r0 + chunk);
+                for (size_t g = 0; g < groups; g++) {
+                    auto byte = [&](size_t r) { return size_t(a.row(r)[g / 8] >> (g % 8 * 8)) & 0xff; };
+                    // Для разреженной группы таблица не окупается: объединяем строки b напрямую.
+                    size_t bits = 0;
+                    for (size_t r = r0; r < r1 && bits <= 256; r++) bits += __builtin_popcountll(byte(r));
+                    if (bits <= 256) {
+                        for (size_t r = r0; r < r1; r++) {
+                            for (size_t x = byte(r); x != 0; x &= x - 1) orWords(c.row(r), b.row(g * 8 + __builtin_ctzll(x)), b._stride);
+                        }
+                        continue;
+                    }
+                    // Таблица: table[x] = OR строк b с номерами 8g + i для единичных битов i байта x.
+                    const size_t rows = min(size_t(8), b._h - g * 8);
+                    const size_t entries = size_t(1) << rows;
+                    fill(table.begin(), table.begin() + b._stride, 0);
+                    for (size_t x = 1; x < entries; x++) {
+                        const size_t low = __builtin_ctzll(x);
+                        Word* dst = table.data() + x * b._stride;
+                        const Word* rest = table.data() + (x & (x - 1)) * b._stride;
+                        const Word* src = b.row(g * 8 + low);
+                        for (size_t i = 0; i < b._stride; i++) dst[i] = rest[i] | src[i];
+                    }
+                    for (size_t r = r0; r < r1; r++) {
+                        const size_t x = byte(r);
+                        if (x != 0) orWords(c.row(r), table.data() + x * b._stride, b._stride);
+                    }
+                }
+            }, 1);
+            return c;
+        }
+
+        // Вывод в поток
+        friend std::ostream& operator << (std::ostream& os, const BitMatrix& m) {
+            for (size_t r = 0; r < m._h; r++) {
+                for (size_t c = 0; c < m._w; c++) os << m.test(r, c);
+                os << "\n";
+            }
+            return os << "\n";
+        }
+    };
+}
+
+#endif /* bitMatrix_h */
@@ -0,0 +1,169 @@
+//
+//  compressedBitmap.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сжатое битовое множество для строк транзитивного замыкания.
+
+#ifndef compressedBitmap_h
+#define compressedBitmap_h
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+
+using namespace std;
+
+namespace Graph {
+
+    // Сжатое множество 32-битных чисел по схеме Roaring. Chambi, Lemire, Kaser, Godin 2016.
+    // Числа делятся на блоки по старшим 16 битам. Блок - контейнер младших 16 бит:
+    // - массив: отсортированные uint16_t, пока элементов не больше ARRAY_MAX;
+    // - битовая карта: 2^16 бит (8 КБ), когда элементов больше.
+    // Память ~2 байта на элемент для разреженных блоков и 1 бит для плотных, поиск O(lg) по блокам и массиву.
+    class RoaringBitmap {
+        static constexpr size_t ARRAY_MAX = 4096; // Массив больше 4096 * 2 байт не меньше битовой карты.
+        static constexpr size_t BITMAP_WORDS = 65536 / 64;
+
+        struct Container {
+            vector<uint16_t> array; // Если bitmap пуст.
+            vector<uint64_t> bitmap;
+            uint32_t card = 0;
+
+            bool isBitmap() const { return !bitmap.empty(); }
+
+            bool contains(uint16_t x) const {
+                if (isBitmap()) return (bitmap[x / 64] >> (x % 64)) & 1;
+                return binary_search(array.begin(), array.end(), x);
+            }
+
+            void toBitmap_() {
+                bitmap.assign(BITMAP_WORDS, 0);
+                for (uint16_t x : array) bitmap[x / 64] |= uint64_t(1) << (x % 64);
+                array.clear();
+                array.shrink_to_fit();
+            }
+
+            void add(uint16_t x) {
+                if (isBitmap()) {
+                    uint64_t& word = bitmap[x / 64];
+                    uint64_t bit = uint64_t(1) << (x % 64);
+                    card += !(word & bit);
+                    word |= bit;
+                    return;
+                }
+                auto it = lower_bound(array.begin(), array.end(), x);
+                if (it != array.end() && *it == x) return;
+                array.insert(it, x);
+                if (++card > ARRAY_MAX) toBitmap_();
+            }
+
+            void orWith(const Container& c) {
+                if (c.isBitmap()) {
+                    if (!isBitmap()) {
+                        vector<uint16_t> a;
+                        a.swap(array);
+                        bitmap = c.bitmap;
+                        for (uint16_t x : a) bitmap[x / 64] |= uint64_t(1) << (x % 64);
+                    } else {
+                        for (size_t i = 0; i < BITMAP_WORDS; i++) bitmap[i] |= c.bitmap[i];
+                    }
+                    card = 0;
+                    for (uint64_t w : bitmap) card += __builtin_popcountll(w);
+                } else if (isBitmap()) {
+                    for (uint16_t x : c.array) add(x);
+                } else {
+                    vector<uint16_t> u;
+                    u.reserve(array.size() + c.array.size());
+                    set_union(array.begin(), array.end(), c.array.begin(), c.array.end(), back_inserter(u));
+                    array.swap(u);
+                    card = uint32_t(array.size());
+                    if (card > ARRAY_MAX) toBitmap_();
+                }
+            }
+
+            size_t memory() const {
+                return sizeof(Container) + array.capacity() * sizeof(uint16_t) + bitmap.capacity() * sizeof(uint64_t);
+            }
+        };
+
+        vector<uint16_t> _keys; // Старшие 16 бит блоков по возрастанию.
+        vector<Container> _containers;
+
+    public:
+        bool contains(uint32_t x) const {
+            auto it = lower_bound(_keys.begin(), _keys.end(), uint16_t(x >> 16));
+            if (it == _keys.end() || *it != uint16_t(x >> 16)) return false;
+            return _containers[it - _keys.begin()].contains(uint16_t(x));
+        }
+
+        void add(uint32_t x) {
+            auto it = lower_bound(_keys.begin(), _keys.end(), uint16_t(x >> 16));
+            size_t i = it - _keys.begin();
+            if (it == _keys.end() || *it != uint16_t(x >> 16)) {
+                _keys.insert(it, uint16_t(x >> 16));
+                _containers.insert(_containers.begin() + i, Container());
+            }
+            _containers[i].add(uint16_t(x));
+        }
+
+        // Объединение множеств.
+        RoaringBitmap& operator |= (const RoaringBitmap& b) {
+            vector<uint16_t> keys;
+            vector<Container> containers;
+            keys.reserve(_keys.size() + b._keys.size());
+            containers.reserve(_keys.size() + b._keys.size());
+            size_t i = 0, j = 0;
+            while (i < _keys.size() || j < b._keys.size()) {
+                if (j == b._keys.size() || (i < _keys.size() && _keys[i] < b._keys[j])) {
+                    keys.push_back(_keys[i]);
+                    containers.push_back(std::move(_containers[i++]));
+                } else if (i == _keys.size() || b._keys[j] < _keys[i]) {
+                    keys.push_back(b._keys[j]);
+                    containers.push_back(b._containers[j++]);
+                } else {
+                    keys.push_back(_keys[i]);
+                    containers.push_back(std::move(_containers[i++]));
+                    containers.back().orWith(b._containers[j++]);
+                }
+            }
+            _keys.swap(keys);
+            _containers.swap(containers);
+            return *this;
+        }
+
+        // Количество элементов.
+        size_t count() const {
+            size_t c = 0;
+            for (const auto& ct : _containers) c += ct.card;
+            return c;
+        }
+
+        // f(x) для всех элементов по возрастанию.
+        template <class F> void forEach(F&& f) const {
+            for (size_t i = 0; i < _keys.size(); i++) {
+                const uint32_t high = uint32_t(_keys[i]) << 16;
+                const Container& c = _containers[i];
+                if (c.isBitmap()) {
+                    for (size_t k = 0; k < BITMAP_WORDS; k++) {
+                        for (uint64_t x = c.bitmap[k]; x != 0; x &= x - 1) f(high | uint32_t(k * 64 + __builtin_ctzll(x)));
+                    }
+                } else {
+                    for (uint16_t x : c.array) f(high | x);
+                }
+            }
+        }
+
+        // Занимаемая память в байтах.
+        size_t memory() const {
+            size_t m = sizeof(RoaringBitmap) + _keys.capacity() * sizeof(uint16_t);
+            for (const auto& c : _containers) m += c.memory();
+            return m + (_containers.capacity() - _containers.size()) * sizeof(Container);
+        }
+    };
+}
+
+#endif /* compressedBitmap_h */
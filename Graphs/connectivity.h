@@ -0,0 +1,115 @@
+//
+//  connectivity.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Связность неориентированного графа, пополняемого потоком рёбер.
+
+#ifndef connectivity_h
+#define connectivity_h
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+#include "graphBase.h"
+#include "disjointSet.h"
+#include "parallel.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Инкрементальная связность. Рёбра только добавляются, в любой момент доступны за ~O(1):
+    // connected(v, w), размер компоненты вершины и количество компонент.
+    // В отличие от CC_T граф не хранится и не перестраивается на каждый снимок: O(V) памяти независимо от E.
+    // Вершины добавляются по мере появления в потоке рёбер.
+    // DS - лес непересекающихся множеств: DisjointSet или компактный DisjointSet32.
+    // С ConcurrentDisjointSet рёбра можно добавлять и опрашивать связность из нескольких потоков одновременно,
+    // но количество вершин фиксируется в конструкторе, а размеры компонент не поддерживаются - их даёт снимок labels().
+    template <class DS = DisjointSet> class Connectivity_T {
+        DS _ds;
+        typename conditional<DS::concurrent, atomic<size_t>, size_t>::type _edges{0}; // Количество принятых рёбер.
+
+    public:
+        Connectivity_T(size_t vertices = 0) : _ds(vertices) { trace("Connectivity_T"); }
+
+        // Связность готового графа g. Направление рёбер ориентированного графа не учитывается (слабая связность).
+        // С ConcurrentDisjointSet рёбра добавляются параллельно.
+        template <class G, class = typename G::Traits> Connectivity_T(const G& g) : Connectivity_T(g.size()) {
+            auto insertAdjacent = [&](size_t v) {
+                for (size_t w : g.adjacent(v)) {
+                    if (G::Traits::directed || v <= w) insert(v, w);
+                }
+            };
+            if constexpr (DS::concurrent) {
+                prepareForParallel(g);
+                parallelFor(0, g.size(), insertAdjacent, 256);
+            } else {
+                for (size_t v = 0; v < g.size(); v++) insertAdjacent(v);
+            }
+        }
+
+        // Добавляет ребро {v, w}. Возвращает true, если ребро объединило две компоненты.
+        bool insert(size_t v, size_t w) {
+            if constexpr (DS::concurrent) assert(v < size() && w < size());
+            else _ds.resize(std::max(v, w) + 1);
+            _edges++;
+            return _ds.uniteIfNotConnected(v, w);
+        }
+
+        // Добавляет рёбра из [first, last). Возвращает количество объединений компонент.
+        template <class It> size_t insert(It first, It last) {
+            size_t merged = 0;
+            for (; first != last; ++first) {
+                merged += insert(first->v, first->w);
+            }
+            return merged;
+        }
+
+        // Кол-во вершин
+        size_t size() const { return _ds.size(); }
+
+        // Кол-во принятых рёбер, включая повторные.
+        size_t edgesCount() const { return _edges; }
+
+        // Количество компонент связности.
+        size_t count() const { return _ds.count(); }
+
+        // Вершины ещё не встречавшиеся в потоке изолированы.
+        bool connected(size_t v, size_t w) const {
+            if (v >= size() || w >= size()) return v == w;
+            return _ds.isConnected(v, w);
+        }
+
+        // Количество вершин в компоненте v.
+        size_t componentSize(size_t v) const {
+            return v < size() ? _ds.setSize(v) : 1;
+        }
+
+        // Снимок: компактные номера компонент [0, count()) в порядке наименьших вершин, как в CC_T.
+        // Label - тип номера, например uint32_t для экономии памяти. O(V).
+        template <class Label = size_t> vector<Label> labels() const {
+            const size_t n = size();
+            vector<Label> ids(n);
+            vector<Label> rootId(n, Label(-1));
+            Label next = 0;
+            for (size_t v = 0; v < n; v++) {
+                size_t r = _ds.find(v);
+                if (rootId[r] == Label(-1)) rootId[r] = next++;
+                ids[v] = rootId[r];
+            }
+            return ids;
+        }
+    };
+
+    using Connectivity = Connectivity_T<DisjointSet>;
+    using Connectivity32 = Connectivity_T<DisjointSet32>;
+    using ConcurrentConnectivity = Connectivity_T<ConcurrentDisjointSet>;
+}
+
+void connectivityTest();
+
+#endif /* connectivity_h */
@@ -0,0 +1,219 @@
+//
+//  connectivityTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сверка структур связности на случайных графах: параллельных объединений множеств - с поиском связных компонент CC_T,
+// полностью динамической связности - с объединением множеств по текущим рёбрам.
+
+#include <iostream>
+#include <random>
+#include <atomic>
+#include <algorithm>
+#include <set>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "searchGraph.h"
+#include "parallel.h"
+#include "connectivity.h"
+#include "parallelCC.h"
+#include "biconnected.h"
+#include "dynamicConnectivity.h"
+
+using namespace std;
+using namespace Graph;
+
+// Параллельные объединения по рёбрам графа g вперемешку с запросами. Результат сверяется с CC_T.
+template <class DS> static bool concurrentUnions(const SparseGraph& g, const vector<GraphEdge>& edges) {
+    const size_t n = g.size();
+    auto cc = CC(g);
+    DS ds(n);
+    atomic<size_t> merges(0);
+    parallelFor(0, edges.size(), [&](size_t i) {
+        merges += ds.uniteIfNotConnected(edges[i].v, edges[i].w);
+        ds.isConnected(edges[i].w, edges[i].v * 7 % n);
+    }, 16);
+    if (ds.count() != cc.size() || n - merges != cc.size()) return false;
+    for (size_t v = 0; v < n; v++) {
+        for (size_t w = 0; w < n; w++) {
+            if (ds.isConnected(v, w) != cc.connected(v, w)) return false;
+            if ((ds.findReadOnly(v) == ds.findReadOnly(w)) != cc.connected(v, w)) return false;
+        }
+    }
+    return true;
+}
+
+// Случайные вставки и удаления рёбер. После каждой операции count(), connected() и componentSize()
+// сверяются с объединением множеств, построенным заново по текущим рёбрам.
+static bool dynamicConnectivity(mt19937& rnd) {
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 2 + rnd() % 40;
+        DynamicConnectivity dc(n);
+        vector<pair<size_t, size_t>> edges;
+        for (int op = 0; op < 300; op++) {
+            if (edges.empty() || rnd() % 3) {
+                size_t v = rnd() % n, w = rnd() % n;
+                bool fresh = v != w && find_if(edges.begin(), edges.end(), [&](const pair<size_t, size_t>& e) {
+                    return (e.first == v && e.second == w) || (e.first == w && e.second == v);
+                }) == edges.end();
+                if (dc.insert(v, w) != fresh) return false;
+                if (fresh) edges.push_back({v, w});
+            } else {
+                size_t k = rnd() % edges.size();
+                if (!dc.remove(edges[k].second, edges[k].first)) return false;
+                edges[k] = edges.back();
+                edges.pop_back();
+            }
+            DisjointSet ds(n);
+            for (auto& e : edges) ds.uniteIfNotConnected(e.first, e.second);
+            if (dc.count() != ds.count()) return false;
+            for (size_t v = 0; v < n; v++) {
+                if (dc.componentSize(v) != ds.setSize(v)) return false;
+                for (size_t w = 0; w < n; w++) {
+                    if (dc.connected(v, w) != ds.isConnected(v, w)) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Количество компонент связности графа без вершины x. x = -1 - без удаления.
+static size_t componentsWithout(const SparseGraph& g, size_t x) {
+    vector<char> seen(g.size());
+    if (x != -1) seen[x] = true;
+    size_t count = 0;
+    vector<size_t> stack;
+    for (size_t s = 0; s < g.size(); s++) {
+        if (seen[s]) continue;
+        count++;
+        seen[s] = true;
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            size_t v = stack.back(); stack.pop_back();
+            for (size_t w : g.adjacent(v)) {
+                if (!seen[w]) {
+                    seen[w] = true;
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Связаны ли a и b в графе без вершины x.
+static bool connectedWithout(const SparseGraph& g, size_t x, size_t a, size_t b) {
+    vector<char> seen(g.size());
+    seen[x] = seen[a] = true;
+    vector<size_t> stack(1, a);
+    while (!stack.empty()) {
+        size_t v = stack.back(); stack.pop_back();
+        if (v == b) return true;
+        for (size_t w : g.adjacent(v)) {
+            if (!seen[w]) {
+                seen[w] = true;
+                stack.push_back(w);
+            }
+        }
+    }
+    return false;
+}
+
+struct BridgeSet {
+    set<pair<size_t, size_t>> bridges;
+    void visit(const GraphEdge& e) { bridges.insert({min(e.v, e.w), max(e.v, e.w)}); }
+};
+
+// Мосты, шарниры, блоки рёбер и разделение вершин деревом блоков и шарниров сверяются с перебором:
+// шарнир - вершина, удаление которой увеличивает число компонент, рёбра {v, a} и {v, b} в одном блоке
+// тогда и только тогда, когда a и b остаются связаны без v.
+static bool biconnectedComponents(mt19937& rnd) {
+    for (int i = 0; i < 200; i++) {
+        const size_t n = 1 + rnd() % 40, m = rnd() % (2 * n + 1);
+        SparseGraph g(n);
+        for (size_t k = 0; k < m; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            if (v != w) g.insert({v, w});
+        }
+        auto bc = biconnected(g);
+        auto bct = blockCutTree(bc);
+        auto cc = CC(g);
+
+        BridgeSet expected, found;
+        Bridges(g, expected);
+        for (auto& e : bc.bridges()) found.visit(e);
+        if (found.bridges != expected.bridges) return false;
+
+        const size_t components = componentsWithout(g, -1);
+        for (size_t x = 0; x < n; x++) {
+            if (bc.artPoint(x) != (componentsWithout(g, x) > components)) return false;
+            for (size_t a : g.adjacent(x)) {
+                for (size_t b : g.adjacent(x)) {
+                    if ((bc.block(x, a) == bc.block(x, b)) != (a == b || connectedWithout(g, x, a, b))) return false;
+                }
+            }
+            for (size_t a = 0; a < n; a++) {
+                for (size_t b = 0; b < n; b++) {
+                    if (a == x || b == x) continue;
+                    bool separated = cc.connected(a, b) && !connectedWithout(g, x, a, b);
+                    if (bct.separates(x, a, b) != separated) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void connectivityTest()
+{
+    setThreadsCount(4);
+    mt19937 rnd(7);
+    bool index = true, rank = true, labels = true, afforest = true;
+    for (int i = 0; i < 40; i++) {
+        const size_t n = 2 + rnd() % 300, m = rnd() % 450;
+        SparseGraph g(n);
+        vector<GraphEdge> edges;
+        for (size_t k = 0; k < m; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            if (v == w) continue;
+            g.insert({v, w});
+            edges.push_back({v, w});
+        }
+        index &= concurrentUnions<ConcurrentDisjointSet>(g, edges);
+        rank &= concurrentUnions<ConcurrentRankDisjointSet>(g, edges);
+
+        // Метки компонент нумеруются как в CC_T.
+        auto cc = CC(g);
+        ConcurrentConnectivity conn(g);
+        auto l = conn.labels();
+        bool same = conn.count() == cc.size();
+        for (size_t v = 0; v < n; v++) same &= l[v] == cc.id(v);
+        labels &= same;
+
+        // Afforest с разным числом раундов выборки соседей нумерует компоненты как CC_T.
+        CCAfforest_T<SparseGraph> af(g, i % 4);
+        same = af.size() == cc.size();
+        for (size_t v = 0; v < n; v++) same &= af.id(v) == cc.id(v);
+        afforest &= same;
+    }
+    // Крупные графы около порога появления гигантской компоненты.
+    for (int i = 0; i < 4; i++) {
+        const size_t n = 20000;
+        SparseGraph g(n);
+        for (size_t k = 8000 + rnd() % 8000; k > 0; k--) g.insert({rnd() % n, rnd() % n});
+        auto cc = CC(g);
+        CCAfforest_T<SparseGraph> af(g, i);
+        afforest &= af.size() == cc.size();
+        for (size_t v = 0; v < n; v++) afforest &= af.id(v) == cc.id(v);
+    }
+    report("ConcurrentDisjointSet", index);
+    report("ConcurrentRankDisjointSet", rank);
+    report("ConcurrentConnectivity", labels);
+    report("CCAfforest_T", afforest);
+    report("DynamicConnectivity", dynamicConnectivity(rnd));
+    report("Biconnected_T", biconnectedComponents(rnd));
+}
@@ -0,0 +1,149 @@
+//
+//  csrGraph.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+
+#ifndef csrGraph_h
+#define csrGraph_h
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "graphBase.h"
+
+namespace Graph {
+
+    // Неизменяемый граф в сжатом строчном формате (CSR - compressed sparse row).
+    // Списки смежности всех вершин лежат подряд в одном буфере: вершина v занимает [offsets[v], offsets[v+1]).
+    // Строится подсчётом (counting sort) за O(V + E) из любого графа или транспонированием любого графа,
+    // поэтому используется как индекс входящих рёбер ориентированного графа.
+    // Списки смежности упорядочены по возрастанию вершин. Память O(V + E) без накладных расходов vector<vector>.
+    template <class GT = DirectedGraphTraits, class Index = size_t> class CSRGraph_T {
+    public:
+        using Traits = GT;
+        using Edge = typename Traits::EdgeType;
+        using WeightType = typename Traits::WeightType;
+        using NodeType = typename Traits::AdjListNodeType;
+        static constexpr bool weighted = !is_same<WeightType, bool>::value;
+        // Для невзвешенного графа элемент списка смежности - номер вершины.
+        using value_type = typename conditional<weighted, NodeType, size_t>::type;
+
+    private:
+        vector<size_t> _offsets;
+        vector<Index> _targets;
+        vector<typename conditional<weighted, WeightType, char>::type> _weights; // Только для взвешенного графа.
+
+        value_type node_(size_t i) const {
+            if constexpr (weighted) return NodeType(_targets[i], _weights[i]);
+            else return _targets[i];
+        }
+
+        // Вставка узла в позицию pos.
+        template <class Node> void put_(size_t pos, size_t w, const Node& node) {
+            _targets[pos] = Index(w);
+            if constexpr (weighted) _weights[pos] = node.weight;
+        }
+
+        void resize_(size_t edges) {
+            _targets.resize(edges);
+            if constexpr (weighted) _weights.resize(edges);
+        }
+
+        // Префиксные суммы степеней.
+        void offsets_() {
+            for (size_t v = 1; v < _offsets.size(); v++) _offsets[v] += _offsets[v - 1];
+        }
+
+    public:
+        // Список смежности вершины. Для for(:) и доступа по индексу.
+        class AdjIter {
+            const CSRGraph_T& _g;
+            size_t _b, _e;
+        public:
+            class iterator {
+                const CSRGraph_T& _g;
+                size_t _i;
+            public:
+                iterator(const CSRGraph_T& g, size_t i) : _g(g), _i(i) {}
+                value_type operator*() const { return _g.node_(_i); }
+                bool operator != (const iterator& it) const { return _i != it._i; }
+                void operator++() { ++_i; }
+            };
+
+            AdjIter(const CSRGraph_T& g, size_t b, size_t e) : _g(g), _b(b), _e(e) {}
+            iterator begin() const { return {_g, _b}; }
+            iterator end() const { return {_g, _e}; }
+            size_t size() const { return _e - _b; }
+            value_type operator[](size_t i) const { return _g.node_(_b + i); }
+        };
+
+        // Копия графа g или транспонированного графа g.
+        template <class G> CSRGraph_T(const G& g, bool transpose = false) : _offsets(g.size() + 1) {
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) {
+                    _offsets[(transpose ? w : v) + 1]++;
+                }
+            }
+            offsets_();
+            resize_(_offsets.back());
+            vector<size_t> pos(_offsets.begin(), _offsets.end() - 1);
+            // Вершины-истоки перебираются по возрастанию, поэтому транспонированные списки упорядочены.
+            for (size_t v = 0; v < g.size(); v++) {
+                for (auto&& node : g.adjacent(v)) {
+                    size_t w = node;
+                    if (transpose) put_(pos[w]++, v, node);
+                    else put_(pos[v]++, w, node);
+                }
+            }
+        }
+
+        // Граф из списка рёбер. Повторяющиеся рёбра удаляются. Для неориентированного графа добавляются обратные рёбра.
+        CSRGraph_T(size_t vertices, vector<Edge> edges) : _offsets(vertices + 1) {
+            if (!Traits::directed) {
+                const size_t n = edges.size();
+                for (size_t i = 0; i < n; i++) edges.push_back(edges[i].inverse());
+            }
+            sort(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) { return l.v < r.v || (l.v == r.v && l.w < r.w); });
+            edges.erase(unique(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) { return l.v == r.v && l.w == r.w; }), edges.end());
+            resize_(edges.size());
+            for (size_t i = 0; i < edges.size(); i++) {
+                _offsets[edges[i].v + 1]++;
+                put_(i, edges[i].w, edges[i]);
+            }
+            offsets_();
+        }
+
+        // Кол-во вершин
+        size_t size() const { return _offsets.size() - 1; }
+
+        // Кол-во ребер
+        size_t edgesCount() const { return directed() ? _targets.size() : _targets.size() / 2; }
+
+        constexpr bool directed() const { return Traits::directed; }
+
+        // Есть ли ребро {v, w}? O(lg(deg(v))).
+        bool edge(size_t v, size_t w) const {
+            return binary_search(_targets.begin() + _offsets[v], _targets.begin() + _offsets[v + 1], Index(w));
+        }
+
+        AdjIter adjacent(size_t v) const { return {*this, _offsets[v], _offsets[v + 1]}; }
+
+        // Занимаемая память в байтах.
+        size_t memory() const {
+            return _offsets.capacity() * sizeof(size_t) + _targets.capacity() * sizeof(Index) +
+                _weights.capacity() * sizeof(typename decltype(_weights)::value_type);
+        }
+    };
+
+    using CSRGraph = CSRGraph_T<GraphTraits>;
+    using CSRGraphD = CSRGraph_T<DirectedGraphTraits>;
+    using CSRDAG = CSRGraph_T<DAGTraits>;
+
+    // Индекс входящих рёбер графа g - транспонированный граф.
+    template <class G> CSRGraph_T<typename G::Traits> transposed(const G& g) { return CSRGraph_T<typename G::Traits>(g, true); }
+}
+
+#endif /* csrGraph_h */
@@ -12,55 +12,14 @@
 
 #include "directedGraph.h"
 #include "strongComponents.h"
+#include "compressedBitmap.h"
+#include "parallel.h"
 #include <memory>
 #include <queue>
+#include <atomic>
 
 namespace Graph {
     
-    // Специализация транзитивного замыкания для DAG. Седжвик 19.9
-    // Обратных ребер нет. В прямых и перекрёстных ребрах DFS уже заверщен.
-    // О(V(V+X)) где X - число перекрёстных ребер.
-    template <class G> class TC_T<G, DAGTraits> {
-        const G& g;
-        vector<size_t> enter;
-        size_t cnt = 0;
-        // Исходим из предположения, что граф транзитивного замыкания будет очень плотным.
-        // Плюс граф на списках смежности не приспособлен для использования с динамической вставкой ребер.
-        DenseGraphD tc;
-        
-        // Ленивые вычисления.
-        void processIfNeed_() const {
-            if (cnt == 0) {
-                for( size_t v = 0; v < g.size(); v++ ) {
-                    const_cast<TC_T&>(*this).dfs_(v);
-                }
-            }
-        }
-        
-        void dfs_( size_t v ) {
-            enter[v] = cnt++;
-			tc.insert({v, v});
-            for ( size_t w : g.adjacent(v) ) {
-				tc.insert({v, w});
-				if (enter[w] == -1) {
-					dfs_(w); // Для древесных ребер - DFS.
-				} else if ( enter[w] > enter[v] ) {
-					continue; // Для прямых ребер все уже посчитано.
-				}
-                // В строку v кладём OR между w и v строками МСТЗ.
-				for ( size_t i = 0; i < tc.size(); i++ ) {
-                    if ( tc.edge(w, i) ) tc.insert({v, i});
-				}
-            }
-        }
-        
-    public:
-        TC_T( const G& g) : g(g), tc(g.size()), enter(g.size(), -1) { trace("TC_T DAG"); }
-        
-        bool reachable( size_t v, size_t w ) const { processIfNeed_(); return tc.edge(v , w); }
-        const DenseGraphD& getTC() const { processIfNeed_(); return tc; }
-    };
-    
     ///////////////////////////////////////////////////////////////
     // DAG Topoligical Sort. Седжвик 19.6
     template <class G> class TS_T {
@@ -121,73 +80,431 @@ namespace Graph {
         
         std::vector<size_t> _top;
         std::vector<size_t> _relabel;
+        bool _isDag;
     public:
-        TSSQ_T (const G& g) : _top(g.size(), -1), _relabel(g.size(), -1) {
+        TSSQ_T (const G& g) : _relabel(g.size(), -1) { trace("TSSQ_T");
+            _top.reserve(g.size());
             std::vector<size_t> ins(g.size());
             // Заполняем вектор степеней захода для каждой вершины.
-            for (size_t v = 0; v < g.size(); g++) {
-                for (auto w : g.adjacent(v)) {
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) {
                     ins[w]++;
                 }
             }
             
             std::queue<size_t> sq; // source queue.
             // Заполняем очередь истоков.
-            for (size_t v = 0; v < g.size(); g++) {
+            for (size_t v = 0; v < g.size(); v++) {
                 if (ins[v] == 0) {
                     sq.push(v);
                 }
             }
             
             // Удаляем истоки, уменьшаем степени захода вершин куда шли ребра из истоков. Новые истоки заносим в очередь.
-            for (size_t v = 0; !sq.empty(); v++) {
-                size_t s = sq.back();
+            while (!sq.empty()) {
+                size_t s = sq.front();
                 sq.pop();
-                _top[v] = s;
-                _relabel[s] = v;
-                for (auto w : g.adjacent[s]) {
+                _relabel[s] = g.size() - 1 - _top.size();
+                _top.push_back(s);
+                for (size_t w : g.adjacent(s)) {
                     if (--ins[w] == 0) {
                         sq.push(w);
                     }
                 }
             }
+            // Вершины циклов никогда не становятся истоками.
+            _isDag = _top.size() == g.size();
         }
         
+        bool isDAG() const { return _isDag; }
+        
         // Возвращает последовательность вершин в топологическом порядке.
-        const vector<size_t>& ts() { return _top; }
+        const vector<size_t>& ts() const { return _top; }
 
         // Возвращает i-ю вершину в топологическом порядке.
         size_t operator[] (size_t i) const { return _top[i]; }
         
         // Возвращает вектор переименования вершин так, чтобы ребра выходили из вершин с большим номером и входили в вершины с меньшим номером.
-        const vector<size_t>& relabel() { return _relabel; }
+        const vector<size_t>& relabel() const { return _relabel; }
+    };
+    
+    // Ускоритель вызова.
+    template<class G> TSSQ_T<G> TSSQ(const G& g) { return TSSQ_T<G>(g); }
+    
+    ///////////////////////////////////////////////////////////////
+    // DAG Topoligical Sort. Параллельная очередь истоков по уровням.
+    // Уровень 0 - истоки графа, уровень k - вершины, у которых все предки на уровнях меньше k, и хотя бы один на k - 1.
+    // Вершины одного уровня не связаны рёбрами и могут обрабатываться одновременно.
+    // Каждый уровень обрабатывается параллельно: удаление истока атомарно уменьшает степени захода потомков,
+    // потомки с нулевой степенью составляют следующий уровень. O(V + E) работы, число шагов - количество уровней.
+    // Уровни детерминированы, порядок вершин внутри уровня - нет.
+    template <class G> class TSPar_T {
+        std::vector<size_t> _top; // Вершины по уровням.
+        std::vector<size_t> _levels; // Начала уровней в _top и конец последнего.
+        std::vector<size_t> _level; // Уровень вершины.
+        std::vector<size_t> _relabel;
+        bool _isDag;
+
+    public:
+        // Вершины уровня.
+        class Level {
+            const size_t* _b;
+            const size_t* _e;
+        public:
+            Level(const size_t* b, const size_t* e) : _b(b), _e(e) {}
+            const size_t* begin() const { return _b; }
+            const size_t* end() const { return _e; }
+            size_t size() const { return _e - _b; }
+            size_t operator[](size_t i) const { return _b[i]; }
+        };
+
+        TSPar_T (const G& g) : _level(g.size(), -1), _relabel(g.size(), -1) { trace("TSPar_T");
+            prepareForParallel(g);
+            const size_t n = g.size();
+            _top.reserve(n);
+            std::vector<std::atomic<uint32_t>> ins(n);
+            parallelFor(0, n, [&](size_t v) {
+                for (size_t w : g.adjacent(v)) ins[w].fetch_add(1, std::memory_order_relaxed);
+            }, 256);
+
+            for (size_t v = 0; v < n; v++) {
+                if (ins[v].load(std::memory_order_relaxed) == 0) _top.push_back(v);
+            }
+            std::vector<std::vector<size_t>> next(threadsCount());
+            for (size_t b = 0, e = _top.size(); b < e; b = e, e = _top.size()) {
+                _levels.push_back(b);
+                const size_t level = _levels.size() - 1;
+                parallelForT(b, e, [&](size_t i, size_t t) {
+                    size_t v = _top[i];
+                    _level[v] = level;
+                    for (size_t w : g.adjacent(v)) {
+                        // Последний удалённый предок переносит вершину на следующий уровень.
+                        if (ins[w].fetch_sub(1, std::memory_order_acq_rel) == 1) next[t].push_back(w);
+                    }
+                }, 256);
+                for (auto& l : next) {
+                    _top.insert(_top.end(), l.begin(), l.end());
+                    l.clear();
+                }
+            }
+            _levels.push_back(_top.size());
+            for (size_t i = 0; i < _top.size(); i++) _relabel[_top[i]] = n - 1 - i;
+            _isDag = _top.size() == n;
+        }
+
+        bool isDAG() const { return _isDag; }
+
+        // Возвращает последовательность вершин в топологическом порядке. Уровни идут подряд.
+        const vector<size_t>& ts() const { return _top; }
+
+        // Возвращает i-ю вершину в топологическом порядке.
+        size_t operator[] (size_t i) const { return _top[i]; }
+
+        // Возвращает вектор переименования вершин так, чтобы ребра выходили из вершин с большим номером и входили в вершины с меньшим номером.
+        const vector<size_t>& relabel() const { return _relabel; }
+
+        // Количество уровней - длина наидлиннейшего пути в вершинах.
+        size_t levels() const { return _levels.size() - 1; }
+
+        // Вершины i-го уровня.
+        Level level(size_t i) const { return {_top.data() + _levels[i], _top.data() + _levels[i + 1]}; }
+
+        // Уровень вершины. -1 для вершин на циклах и достижимых из них.
+        size_t levelOf(size_t v) const { return _level[v]; }
+    };
+
+    // Ускоритель вызова.
+    template<class G> TSPar_T<G> TSPar(const G& g) { return TSPar_T<G>(g); }
+
+    ///////////////////////////////////////////////////////////////
+    // Динамический DAG с поддержкой топологического порядка при вставке рёбер. Pearce, Kelly 2006.
+    // Ребро v->w, согласное с порядком (ord[v] < ord[w]), вставляется за O(1). Иначе порядок чинится только
+    // в затронутой области [ord[w], ord[v]]:
+    // - F - вершины, достижимые из w, с ord не больше ord[v]. Если среди них v - ребро замкнуло бы цикл и отвергается;
+    // - B - вершины, из которых достижима v, с ord не меньше ord[w];
+    // - занятые F и B позиции порядка раздаются заново: сначала B, затем F, внутри каждого - в прежнем порядке.
+    // O(δ lg δ) на вставку, где δ - размер F и B вместе с их рёбрами. Удаление рёбер порядок не нарушает.
+    // Интерфейс ts(), relabel(), operator[] как у TS_T.
+    class DynamicTS {
+        vector<vector<size_t>> _out, _in; // Списки смежности и обратные.
+        vector<size_t> _ord; // Позиция вершины в порядке.
+        vector<size_t> _top; // Вершина на позиции.
+        size_t _edges = 0;
+        mutable vector<size_t> _relabel;
+        mutable bool _relabelValid = false;
+        vector<uint32_t> _seen; // Эпоха посещения вершины.
+        uint32_t _epoch = 0;
+        vector<size_t> _stack, _forward, _backward, _positions;
+
+        uint32_t nextEpoch_() {
+            if (++_epoch == 0) {
+                fill(_seen.begin(), _seen.end(), 0);
+                _epoch = 1;
+            }
+            return _epoch;
+        }
+
+        void resize_(size_t n) {
+            for (size_t v = _top.size(); v < n; v++) {
+                _ord.push_back(v);
+                _top.push_back(v);
+            }
+            _out.resize(n);
+            _in.resize(n);
+            _seen.resize(n);
+            _relabelValid = false;
+        }
+
+        // F: вершины, достижимые из w, с ord не больше ub. false - достижима v.
+        bool forward_(size_t w, size_t v, size_t ub, uint32_t epoch) {
+            _forward.clear();
+            _stack.assign(1, w);
+            _seen[w] = epoch;
+            while (!_stack.empty()) {
+                size_t x = _stack.back(); _stack.pop_back();
+                _forward.push_back(x);
+                for (size_t y : _out[x]) {
+                    if (y == v) return false;
+                    if (_seen[y] != epoch && _ord[y] < ub) {
+                        _seen[y] = epoch;
+                        _stack.push_back(y);
+                    }
+                }
+            }
+            return true;
+        }
+
+        // B: вершины, из которых достижима v, с ord не меньше lb.
+        void backward_(size_t v, size_t lb, uint32_t epoch) {
+            _backward.clear();
+            _stack.assign(1, v);
+            _seen[v] = epoch;
+            while (!_stack.empty()) {
+                size_t x = _stack.back(); _stack.pop_back();
+                _backward.push_back(x);
+                for (size_t y : _in[x]) {
+                    if (_seen[y] != epoch && _ord[y] > lb) {
+                        _seen[y] = epoch;
+                        _stack.push_back(y);
+                    }
+                }
+            }
+        }
+
+        // Перераспределение позиций F и B: B встаёт перед F.
+        void reorder_() {
+            auto byOrd = [&](size_t a, size_t b) { return _ord[a] < _ord[b]; };
+            sort(_forward.begin(), _forward.end(), byOrd);
+            sort(_backward.begin(), _backward.end(), byOrd);
+            _positions.clear();
+            for (size_t x : _backward) _positions.push_back(_ord[x]);
+            for (size_t x : _forward) _positions.push_back(_ord[x]);
+            sort(_positions.begin(), _positions.end());
+            size_t i = 0;
+            for (size_t x : _backward) _top[_ord[x] = _positions[i++]] = x;
+            for (size_t x : _forward) _top[_ord[x] = _positions[i++]] = x;
+            _relabelValid = false;
+        }
+
+    public:
+        DynamicTS(size_t vertices = 0) { trace("DynamicTS"); resize_(vertices); }
+
+        // Начальный DAG. Порядок строится сразу алгоритмом Кана.
+        template <class G, class = typename G::Traits> DynamicTS(const G& g) {
+            trace("DynamicTS");
+            resize_(g.size());
+            TSSQ_T<G> ts(g);
+            assert(ts.isDAG());
+            for (size_t i = 0; i < g.size(); i++) _ord[_top[i] = ts[i]] = i;
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) {
+                    _out[v].push_back(w);
+                    _in[w].push_back(v);
+                    _edges++;
+                }
+            }
+        }
+
+        size_t size() const { return _top.size(); }
+        size_t edgesCount() const { return _edges; }
+        const vector<size_t>& adjacent(size_t v) const { return _out[v]; }
+
+        // Вставка ребра v->w. Недостающие вершины добавляются в конец порядка.
+        // Возвращает false и не меняет граф, если ребро замыкает цикл.
+        bool insert(size_t v, size_t w) {
+            if (max(v, w) >= size()) resize_(max(v, w) + 1);
+            if (v == w) return false;
+            const size_t lb = _ord[w], ub = _ord[v];
+            if (lb < ub) {
+                const uint32_t epoch = nextEpoch_();
+                if (!forward_(w, v, ub, epoch)) return false;
+                backward_(v, lb, epoch);
+                reorder_();
+            }
+            _out[v].push_back(w);
+            _in[w].push_back(v);
+            _edges++;
+            return true;
+        }
+
+        // Удаление одного ребра v->w. Возвращает false, если ребра нет.
+        bool remove(size_t v, size_t w) {
+            if (max(v, w) >= size()) return false;
+            auto it = find(_out[v].begin(), _out[v].end(), w);
+            if (it == _out[v].end()) return false;
+            _out[v].erase(it);
+            _in[w].erase(find(_in[w].begin(), _in[w].end(), v));
+            _edges--;
+            return true;
+        }
+
+        // Позиция вершины в топологическом порядке.
+        size_t ord(size_t v) const { return _ord[v]; }
+
+        // Возвращает последовательность вершин в топологическом порядке.
+        const vector<size_t>& ts() const { return _top; }
+
+        // Возвращает i-ю вершину в топологическом порядке.
+        size_t operator[] (size_t i) const { return _top[i]; }
+
+        // Возвращает вектор переименования вершин так, чтобы ребра выходили из вершин с большим номером и входили в вершины с меньшим номером.
+        // Пересчитывается после изменения порядка за O(V).
+        const vector<size_t>& relabel() const {
+            if (!_relabelValid) {
+                _relabel.resize(size());
+                for (size_t v = 0; v < size(); v++) _relabel[v] = size() - 1 - _ord[v];
+                _relabelValid = true;
+            }
+            return _relabel;
+        }
+    };
+    
+    ///////////////////////////////////////////////////////////////
+    // Строки замыкания DAG в обратном топологическом порядке. Goralčíková, Koubek 1979.
+    // К строке v строки всех потомков уже готовы, и строка v = {v} + OR строк потомков по 64 бита за инструкцию.
+    // Потомки перебираются по возрастанию уровня TSPar_T. Если потомок уже есть в строке v, он достижим через
+    // потомка с меньшим уровнем: ребро лишнее, его строка не объединяется. Остальные рёбра - транзитивное
+    // сокращение, для них вызывается keep(v, w) - одновременно из разных потоков для разных v.
+    // Вершины одного уровня независимы, уровни обрабатываются снизу вверх параллельно.
+    // O(V * R / 64) слов, где R - рёбра транзитивного сокращения.
+    template <class G, class Keep> void closeDAG(const G& g, BitMatrix& tc, Keep&& keep) {
+        TSPar_T<G> ts(g);
+        assert(ts.isDAG());
+        vector<vector<size_t>> children(threadsCount());
+        for ( size_t l = ts.levels(); l-- > 0; ) {
+            auto level = ts.level(l);
+            parallelForT(0, level.size(), [&](size_t i, size_t t) {
+                size_t v = level[i];
+                BitMatrix::Word* row = tc.row(v);
+                tc.set(v, v);
+                auto& ch = children[t];
+                ch.clear();
+                for ( size_t w : g.adjacent(v) ) ch.push_back(w);
+                sort(ch.begin(), ch.end(), [&](size_t a, size_t b) { return ts.levelOf(a) < ts.levelOf(b); });
+                for ( size_t w : ch ) {
+                    if ( tc.test(v, w) ) continue;
+                    BitMatrix::orWords(row, tc.row(w), tc.stride());
+                    keep(v, w);
+                }
+            }, 16);
+        }
+    }
+
+    // Специализация транзитивного замыкания для DAG. Седжвик 19.9
+    // Строится сразу в конструкторе алгоритмом closeDAG, запросы потокобезопасны.
+    template <class G> class TC_T<G, DAGTraits> {
+        BitMatrix tc;
+        
+    public:
+        TC_T( const G& g) : tc(g.size(), g.size()) { trace("TC_T DAG");
+            closeDAG(g, tc, [](size_t, size_t) {});
+        }
+        
+        bool reachable( size_t v, size_t w ) const { return tc.test(v, w); }
+        DenseGraphD getTC() const { return tc.toGraph<DenseGraphD>(); }
+        // Замыкание в виде битовой матрицы достижимости.
+        const BitMatrix& bits() const { return tc; }
+    };
+    
+    ///////////////////////////////////////////////////////////////
+    // Транзитивное сокращение DAG - наименьший граф с той же достижимостью. Aho, Garey, Ullman 1972.
+    // Для DAG оно единственно: ребро v->w остаётся, если w недостижима из других потомков v.
+    // Рёбра отбираются попутно с построением замыкания closeDAG, само замыкание после построения освобождается.
+    // Память V^2 / 8 байт на время построения.
+    template <class G> class TR_T {
+        G tr;
+        size_t removedCnt = 0;
+        
+    public:
+        TR_T( const G& g ) : tr(g.size()) { trace("TR_T");
+            vector<vector<size_t>> kept(g.size());
+            {
+                BitMatrix tc(g.size(), g.size());
+                closeDAG(g, tc, [&](size_t v, size_t w) { kept[v].push_back(w); });
+            }
+            size_t cnt = 0;
+            for ( size_t v = 0; v < g.size(); v++ ) {
+                for ( size_t w : kept[v] ) tr.insert({v, w});
+                cnt += kept[v].size();
+            }
+            removedCnt = g.edgesCount() - cnt;
+        }
+        
+        // Граф транзитивного сокращения.
+        const G& getTR() const { return tr; }
+
+        // Количество удалённых лишних рёбер.
+        size_t removed() const { return removedCnt; }
     };
     
     // Ускоритель вызова.
-    template<class G> TS_T<G> TSSQ(const G& g) { return TS_T<G>(g); }
+    template<class G> TR_T<G> TR(const G& g) { return TR_T<G>(g); }
     
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Транзитивное замыкание на основе сильных компонент. Седжвик 19.13.
-	// Сначала вычисляем сильные компоненты по алгоритму Габова, потом строим базовый DAG. Потом строим ТС базового DAG.
-	template<class G> class TCSC_T {
+	// Сначала вычисляем сильные компоненты алгоритмом SC (по умолчанию Габова, для больших графов - SCPar_T),
+	// потом строим базовый DAG в CSR (Condensation_T).
+	// Строки замыкания DAG - сжатые множества RoaringBitmap. SC нумерует компоненты в обратном топологическом
+	// порядке, поэтому строки потомков готовы раньше строки компоненты: строка c = {c} + OR строк потомков.
+	// Потомок, уже попавший в строку, пропускается - его строка в ней целиком.
+	// Память и время зависят от плотности замыкания, а не от V^2.
+	template<class G, class SC = SCGab_T<G>> class TCSC_T {
 		const G& g;
-		SCGab_T<G> sc;
-		DenseDAG dag; // Удобно реализовано избавление от многократного дублирования ребер.
-		TC_T<DenseDAG> dagTC;
+		Condensation_T<G, SC> sc;
+		vector<RoaringBitmap> tc; // Строки замыкания базового DAG.
 		
 	public:
-		TCSC_T( const G& g ) : g(g), sc(g), dag(sc.size()), dagTC(dag) { trace("TCSC_T");
-			for ( size_t v = 0; v < g.size(); v++ )
-				for ( size_t w : g.adjacent(v) )
-					dag.insert({sc.id(v), sc.id(w)});
+		TCSC_T( const G& g ) : g(g), sc(g), tc(sc.size()) { trace("TCSC_T");
+			const auto& dag = sc.dag();
+			for ( size_t c = 0; c < dag.size(); c++ ) {
+				tc[c].add(uint32_t(c));
+				auto adj = dag.adjacent(c);
+				// Потомки с большими номерами топологически выше, их строки шире.
+				for ( size_t i = adj.size(); i-- > 0; ) {
+					size_t d = adj[i];
+					assert(d < c);
+					if ( !tc[c].contains(uint32_t(d)) ) tc[c] |= tc[d];
+				}
+			}
 		}
 		
-		bool reachable( size_t v, size_t w ) const { return dagTC.reachable(sc.id(v) ,sc.id(w)); }
+		bool reachable( size_t v, size_t w ) const { return tc[sc.id(v)].contains(uint32_t(sc.id(w))); }
+
+		// Занимаемая память замыкания и базового DAG в байтах.
+		size_t memory() const {
+			size_t m = sc.dag().memory();
+			for ( const auto& row : tc ) m += row.memory();
+			return m;
+		}
 		
         void out(std::ostream& os) {
-			os << dag;
+			os << sc.dag();
 			os << "DAG TC\n";
-			os << dagTC.getTC();
+			for ( size_t c = 0; c < tc.size(); c++ ) {
+				os << setw(2) << c << ":";
+				tc[c].forEach([&](size_t d) { os << setw(2) << d << " "; });
+				os << endl;
+			}
 			os << "Result TC\n";
 			for ( size_t v = 0; v < g.size(); v++ ) os << sc.id(v) << ", ";
 			os << endl;
@@ -205,4 +522,6 @@ namespace Graph {
 			
 };
 
+void dagTest();
+
 #endif /* dag_h */
@@ -0,0 +1,163 @@
+//
+//  dagTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Проверка динамического топологического порядка на случайных последовательностях вставок и удалений рёбер.
+
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "parallel.h"
+#include "dag.h"
+
+using namespace std;
+using namespace Graph;
+
+// Есть ли путь s -> t по спискам adj.
+static bool path(const vector<vector<size_t>>& adj, size_t s, size_t t) {
+    vector<bool> seen(adj.size());
+    vector<size_t> stack(1, s);
+    seen[s] = true;
+    while (!stack.empty()) {
+        size_t v = stack.back(); stack.pop_back();
+        if (v == t) return true;
+        for (size_t w : adj[v]) {
+            if (!seen[w]) {
+                seen[w] = true;
+                stack.push_back(w);
+            }
+        }
+    }
+    return false;
+}
+
+// Порядок - перестановка вершин, и каждое хранимое ребро v->w идёт вперёд: ord(v) < ord(w).
+static bool validOrder(const DynamicTS& ts) {
+    for (size_t v = 0; v < ts.size(); v++) {
+        if (ts[ts.ord(v)] != v) return false;
+        for (size_t w : ts.adjacent(v)) {
+            if (ts.ord(v) >= ts.ord(w)) return false;
+        }
+    }
+    return true;
+}
+
+// Вставка отклоняется ровно тогда, когда ребро замкнуло бы цикл. Порядок проверяется после каждой операции.
+static bool dynamicTS(mt19937& rnd) {
+    for (int i = 0; i < 300; i++) {
+        const size_t n = 2 + rnd() % 60;
+        DynamicTS ts(i % 2 ? n : 0); // Без заданного размера вершины добавляются вставкой.
+        vector<vector<size_t>> adj(n);
+        for (size_t k = 0; k < 4 * n; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            bool cycle = v == w || path(adj, w, v);
+            if (ts.insert(v, w) == cycle) return false;
+            if (!cycle) adj[v].push_back(w);
+            if (k % 7 == 0 && !adj[v].empty()) {
+                size_t x = adj[v].back();
+                adj[v].pop_back();
+                if (!ts.remove(v, x)) return false;
+            }
+            if (ts.size() <= max(v, w) || !validOrder(ts)) return false;
+        }
+        // Построение по графу.
+        SparseGraphD g(n);
+        for (size_t v = 0; v < n; v++)
+            for (size_t w : adj[v]) g.insert({v, w});
+        DynamicTS fromGraph(g);
+        if (!validOrder(fromGraph) || fromGraph.edgesCount() != g.edgesCount()) return false;
+    }
+    return true;
+}
+
+// Переименование - перестановка, рёбра идут от больших номеров к меньшим, ts() - вершины по убыванию номеров.
+template <class TS> static bool validRelabel(const TS& ts, const SparseGraphD& g) {
+    const auto& r = ts.relabel();
+    if (!ts.isDAG() || ts.ts().size() != g.size()) return false;
+    for (size_t i = 0; i < g.size(); i++) {
+        if (r[ts[i]] != g.size() - 1 - i) return false;
+    }
+    for (size_t v = 0; v < g.size(); v++) {
+        for (size_t w : g.adjacent(v)) {
+            if (r[v] <= r[w]) return false;
+        }
+    }
+    return true;
+}
+
+// Случайный DAG: рёбра согласны со случайной перестановкой вершин.
+static SparseGraphD randomDAG(mt19937& rnd, size_t n, size_t m) {
+    vector<size_t> perm(n);
+    for (size_t v = 0; v < n; v++) perm[v] = v;
+    shuffle(perm.begin(), perm.end(), rnd);
+    SparseGraphD g(n);
+    for (size_t k = 0; k < m; k++) {
+        size_t v = rnd() % n, w = rnd() % n;
+        if (v != w) g.insert({perm[min(v, w)], perm[max(v, w)]});
+    }
+    return g;
+}
+
+// Топологические сортировки очередью истоков: последовательная и параллельная по уровням.
+// Уровень вершины - длина наидлиннейшего пути в неё, считается по порядку TSSQ_T.
+// Ребро, замыкающее цикл, делает граф не DAG, вершины цикла остаются без уровня.
+static bool sourceQueue(mt19937& rnd) {
+    for (int i = 0; i < 300; i++) {
+        const size_t n = 1 + rnd() % 300;
+        SparseGraphD g = randomDAG(rnd, n, rnd() % (3 * n + 1));
+        auto sq = TSSQ(g);
+        auto par = TSPar(g);
+        if (!validRelabel(sq, g) || !validRelabel(par, g)) return false;
+
+        vector<size_t> depth(n);
+        size_t levels = 0;
+        for (size_t v : sq.ts()) {
+            levels = max(levels, depth[v] + 1);
+            for (size_t w : g.adjacent(v)) depth[w] = max(depth[w], depth[v] + 1);
+        }
+        if (par.levels() != levels) return false;
+        for (size_t v = 0; v < n; v++) {
+            if (par.levelOf(v) != depth[v]) return false;
+            for (size_t w : g.adjacent(v)) {
+                if (par.levelOf(w) <= par.levelOf(v)) return false;
+            }
+        }
+        for (size_t l = 0; l < par.levels(); l++) {
+            for (size_t v : par.level(l)) {
+                if (par.levelOf(v) != l) return false;
+            }
+        }
+
+        // Обратное ребро к началу самого длинного пути замыкает цикл.
+        if (levels < 2) continue;
+        size_t last = par.level(levels - 1)[0], first = last;
+        while (depth[first] != 0) {
+            for (size_t u = 0; u < n; u++) {
+                auto adj = g.adjacent(u);
+                if (depth[u] + 1 == depth[first] && find(adj.begin(), adj.end(), first) != adj.end()) {
+                    first = u;
+                    break;
+                }
+            }
+        }
+        g.insert({last, first});
+        if (TSSQ(g).isDAG() || TSPar(g).isDAG()) return false;
+        auto cyclic = TSPar(g);
+        if (cyclic.levelOf(first) != -1 || cyclic.levelOf(last) != -1) return false;
+    }
+    return true;
+}
+
+void dagTest()
+{
+    setThreadsCount(4);
+    mt19937 rnd(44);
+    report("TSSQ_T, TSPar_T", sourceQueue(rnd));
+    report("DynamicTS", dynamicTS(rnd));
+}
@@ -9,6 +9,13 @@
 #ifndef debug_h
 #define debug_h
 
+#include <iostream>
+#include <iomanip>
+#include <type_traits>
+#include <vector>
+#include <valarray>
+#include <array>
+
 template<typename Array>
 typename std::enable_if<
 std::is_same<Array, std::vector<typename Array::value_type>>::value
@@ -20,13 +27,18 @@ operator<< (std::ostream& out, const Array& v) {
     auto space = "";
     for (auto i = 0; i < v.size(); i++) {
         std::cout << space;
-        std::cout << setw(2) << v[i];
+        std::cout << std::setw(2) << v[i];
         space = " ";
     }
     out << "]" << std::endl;
     return out;
 }
 
+// Строка отчёта проверки: имя и OK или FAIL.
+inline void report(const char* name, bool ok) {
+    std::cout << std::setw(28) << name << ": " << (ok ? "OK" : "FAIL") << "\n";
+}
+
 #ifdef DEBUG
     #define	trace(s)	(cout << endl << s << endl)
 	#define debug(s)	s
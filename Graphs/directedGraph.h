@@ -12,9 +12,13 @@
 #include "debug.h"
 #include "graphBase.h"
 #include "searchGraph.h"
+#include "denseGraph.h"
+#include "bitMatrix.h"
+#include "parallel.h"
 #include <cassert>
 #include <algorithm>
 #include <ostream>
+#include <atomic>
 
 using namespace std;
 
@@ -64,31 +68,94 @@ namespace Graph {
     // Идея: В конце 0-й итерации по i. Результирующий граф содержит 1 на пересечении s и t в случае ориентированного пути s-t или s-0-t.
     // После 1-й итерации 1 добавляется в случае: s-1-t, s-1-0-t, s-0-1-t. И т.д.
     // После i-й итерации 1 добавляется в случае пути s-t который не содержит вершин > i.
+    // Итерация i - это "каждая строка s, в которой есть i, объединяется со строкой i". Строки - битовые множества
+    // BitMatrix, поэтому объединение идёт по 64 бита (с AVX2/AVX-512 по 256/512) за инструкцию: O(V^3/64).
+    // Блочная схема: итерации i идут блоками по block строк, блок опорных строк помещается в L2.
+    // 1. Опорные строки блока замыкаются между собой обычным Уоршеллом.
+    // 2. Остальные строки обрабатываются параллельно. Для строки s по словам столбцов блока определяются опорные
+    //    строки i, которые последовательный алгоритм объединил бы с s, затем они объединяются со всей строкой s.
+    //    Опорные строки уже содержат пути через весь блок - это надмножество, но лишних путей в нём нет.
     // Эффективен для плотных графов на матрице смежности.
     class TCW {
         // Исходим из предположения, что граф транзитивного замыкания будет очень плотным.
-        // Плюс граф на списках смежности не приспособлен для использования с динамической вставкой ребер.
-        DenseGraphD tc;
+        BitMatrix tc;
+
+        // Строка s объединяется со строками блока [b, e), биты которых в s есть или появляются по ходу.
+        void closeRow_(size_t s, size_t b, size_t e, vector<size_t>& pivots) {
+            using Word = BitMatrix::Word;
+            const size_t wb = b / BitMatrix::WORD_BITS, we = (e - 1) / BitMatrix::WORD_BITS + 1;
+            Word* row = tc.row(s);
+            pivots.clear();
+            // Сначала только слова столбцов блока - от них зависит, какие опорные строки нужны.
+            for (size_t i = b; i < e; i++) {
+                if (tc.test(s, i)) {
+                    BitMatrix::orWords(row + wb, tc.row(i) + wb, we - wb);
+                    pivots.push_back(i);
+                }
+            }
+            for (size_t i : pivots) {
+                BitMatrix::orWords(row, tc.row(i), wb);
+                BitMatrix::orWords(row + we, tc.row(i) + we, tc.stride() - we);
+            }
+        }
+
     public:
-        TCW (const DenseGraphD& g) : tc(g) { trace("TC Warshall");
-            for ( size_t i = 0; i < g.size(); i++ ) {
-                tc.insert({i, i});
+        template <class G> TCW(const G& g, size_t block = 256) : tc(g) { trace("TC Warshall");
+            const size_t n = g.size();
+            block = max<size_t>(block, 1); // Пустой блок зациклил бы перебор блоков.
+            for ( size_t i = 0; i < n; i++ ) {
+                tc.set(i, i);
             }
-            for ( size_t i = 0; i < g.size(); i++ ) {
-                for ( size_t s = 0; s < g.size(); s++ ) {
-                    if( tc.edge(s, i) ) {
-                        for( size_t t = 0; t < g.size(); t++ ) {
-                            if ( tc.edge(i, t) ) {
-                                tc.insert({s, t});
-                            }
-                        }
+            for (size_t b = 0; b < n; b += block) {
+                const size_t e = min(n, b + block);
+                // 1. Опорные строки.
+                for (size_t i = b; i < e; i++) {
+                    for (size_t s = b; s < e; s++) {
+                        if (s != i && tc.test(s, i)) tc.orRow(s, i);
                     }
                 }
+                // 2. Остальные строки.
+                vector<vector<size_t>> pivots(threadsCount());
+                parallelForT(0, n, [&](size_t s, size_t t) {
+                    if (s < b || s >= e) closeRow_(s, b, e, pivots[t]);
+                }, 16);
             }
         }
         
-        bool reachable( size_t v, size_t w ) const { return tc.edge(v , w); }
-        const DenseGraphD& getTC() const { return tc; }
+        bool reachable( size_t v, size_t w ) const { return tc.test(v , w); }
+        DenseGraphD getTC() const { return tc.toGraph<DenseGraphD>(); }
+        // Замыкание в виде битовой матрицы достижимости.
+        const BitMatrix& bits() const { return tc; }
+    };
+
+    /////////////////////////////////////////////////////////////////////////////////////
+    // TransitiveClosure - Транзитивное замыкание возведением в квадрат матрицы достижимости. Седжвик 19.3
+    // R = A + I. После k возведений в квадрат R содержит все пути длины не больше 2^k.
+    // Умножение - метод четырёх русских над упакованными строками BitMatrix, многопоточное.
+    // Возведение прекращается, как только квадрат не добавляет битов: для графа диаметра d это ceil(lg(d)) + 1 умножений.
+    // O(V^3 lg(d) / 512). Выигрывает у TCW на графах малого диаметра.
+    class TCFR {
+        BitMatrix tc;
+        size_t squarings = 0; // Количество выполненных умножений.
+    public:
+        template <class G> TCFR(const G& g) : tc(g) { trace("TC Four Russians");
+            for ( size_t i = 0; i < g.size(); i++ ) {
+                tc.set(i, i);
+            }
+            for (;;) {
+                BitMatrix r = tc * tc;
+                squarings++;
+                if (r == tc) break;
+                tc = std::move(r);
+            }
+        }
+
+        bool reachable( size_t v, size_t w ) const { return tc.test(v , w); }
+        DenseGraphD getTC() const { return tc.toGraph<DenseGraphD>(); }
+        // Замыкание в виде битовой матрицы достижимости.
+        const BitMatrix& bits() const { return tc; }
+        // Количество умножений до сходимости.
+        size_t iterations() const { return squarings; }
     };
 	
 	//////////////////////////////////////////////////////////////////////////////////
@@ -121,6 +188,60 @@ namespace Graph {
 	
 	// Ускоритель вызова.
 	template<class G> TC_T<G> TC(const G& g) { return TC_T<G>(g); }    
+
+    //////////////////////////////////////////////////////////////////////////////////
+    // TransitiveClosure - параллельное транзитивное замыкание на основе DFS из каждой вершины.
+    // Поиски из разных истоков независимы, поэтому распределяются по потокам. Строка истока - битовое множество
+    // BitMatrix, в которую пишет только поток, обрабатывающий исток. Она же служит множеством посещённых вершин.
+    // Поиск обрывается досрочно:
+    // - если строка насыщена - достижимы все вершины;
+    // - в вершине w, строка которой уже готова: она объединяется целиком, спуск в w не нужен.
+    // O(V(V+E)) в худшем случае, на практике много меньше за счёт готовых строк.
+    template <class G> class TCPar_T {
+        BitMatrix tc;
+        vector<atomic<bool>> done; // Строка вершины готова.
+
+        void dfs_(const G& g, size_t s, vector<size_t>& stack) {
+            const size_t n = g.size();
+            BitMatrix::Word* row = tc.row(s);
+            size_t cnt = 1;
+            tc.set(s, s);
+            stack.assign(1, s);
+            while (!stack.empty() && cnt < n) {
+                size_t v = stack.back(); stack.pop_back();
+                for (size_t w : g.adjacent(v)) {
+                    if (tc.test(s, w)) continue;
+                    if (done[w].load(memory_order_acquire)) {
+                        BitMatrix::orWords(row, tc.row(w), tc.stride());
+                        cnt = tc.rowCount(s);
+                        if (cnt == n) break;
+                    } else {
+                        tc.set(s, w);
+                        cnt++;
+                        stack.push_back(w);
+                    }
+                }
+            }
+            done[s].store(true, memory_order_release);
+        }
+
+    public:
+        TCPar_T(const G& g) : tc(g.size(), g.size()), done(g.size()) { trace("TC_T parallel DFS");
+            prepareForParallel(g);
+            vector<vector<size_t>> stacks(threadsCount());
+            parallelForT(0, g.size(), [&](size_t s, size_t t) { dfs_(g, s, stacks[t]); }, 8);
+        }
+
+        bool reachable( size_t v, size_t w ) const { return tc.test(v , w); }
+        DenseGraphD getTC() const { return tc.toGraph<DenseGraphD>(); }
+        // Замыкание в виде битовой матрицы достижимости.
+        const BitMatrix& bits() const { return tc; }
+    };
+
+    // Ускоритель вызова.
+    template<class G> TCPar_T<G> TCPar(const G& g) { return TCPar_T<G>(g); }
 }
 
+void tcBenchmark();
+
 #endif /* directedGraphs_h */
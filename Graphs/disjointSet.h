@@ -10,54 +10,73 @@
 #ifndef disjointSet_h
 #define disjointSet_h
 
+#include <cstddef>
 #include <vector>
+#include <atomic>
+#include <utility>
+#include <cstdint>
 
-// Лес непересекающихся множеств на основе деревьев связанных элементов с эвристиками объединения по рангу и сжатия пути.
+// Лес непересекающихся множеств на основе деревьев связанных элементов с эвристиками объединения по размеру и сжатия пути.
 // Кормен Глава 21. (Седжвик 4.11) амортизированно ~O(1).
-class DisjointSet {
-    mutable std::vector<size_t> _root; // Дерево множества - элементы корни деревьев связных множеств.
-    std::vector<size_t> _rank; // Ранг элемента (высота дерева) - ~log[n], n - кол-во дочерних элементов.
-    
-    // Объединяет два связных множество в одно, реализуя эвристику по рангу.
+// Index - тип номера элемента. DisjointSet32 вдвое компактнее при n < 2^32.
+// Не потокобезопасен: find() сжимает путь и пишет в _root даже в const методах. Для потоков - ConcurrentDisjointSet_T.
+template <class Index = size_t> class DisjointSet_T {
+    mutable std::vector<Index> _root; // Дерево множества - элементы корни деревьев связных множеств.
+    std::vector<Index> _size; // Размер множества. Действителен только для корней.
+    size_t _count; // Количество множеств.
+
+    // Объединяет два связных множество в одно, подвешивая меньшее дерево к большему.
     // x, y - корни непересекающихся связных множеств.
     void link_(size_t x, size_t y) {
-        if (_rank[x] > _rank[y]) {
-            _root[y] = x;
-        } else {
-            _root[x] = y;
-            if (_rank[x] == _rank[y]) {
-                ++_rank[y];
-            }
-        }
+        if (_size[x] > _size[y]) std::swap(x, y);
+        _root[x] = Index(y);
+        _size[y] += _size[x];
+        --_count;
     }
-    
+
 public:
-    DisjointSet(size_t n) : _rank(n) {
-        _root.reserve(n);
-        while (n-- != 0) {
-            _root[n] = n;
+    static constexpr bool concurrent = false;
+
+    DisjointSet_T(size_t n = 0) : _count(0) {
+        resize(n);
+    }
+
+    // Добавляет одноэлементные множества до общего количества элементов n. Уменьшение не поддерживается.
+    void resize(size_t n) {
+        size_t i = _root.size();
+        if (n <= i) return;
+        _root.resize(n);
+        _size.resize(n, 1);
+        _count += n - i;
+        for (; i < n; i++) {
+            _root[i] = Index(i);
         }
     }
 
+    // Количество элементов.
+    size_t size() const { return _root.size(); }
+
+    // Количество множеств.
+    size_t count() const { return _count; }
+
+    // Количество элементов множества, в котором находится x.
+    size_t setSize(size_t x) const { return _size[find(x)]; }
+
     bool isConnected(size_t x, size_t y) const {
         return find(x) == find(y);
     }
-    
+
     // Возвращает представителя связного множества - корень дерева связности, реализуя эвристку сжатия пути.
     size_t find(size_t x) const {
         size_t root = x;
         while (_root[root] != root) root = _root[root]; // находим представителя.
         for (size_t y = x; x != root; x = y) { // сжимаем путь.
             y = _root[x];
-            _root[x] = root;
+            _root[x] = Index(root);
         }
         return root;
-//        if ( x == _root[x] ) {
-//            return x;
-//        }
-//        return _root[x] = find(_root[x]);
     }
-    
+
     // Связывает два связных множества в которых находятся элементы x и y в одно.
     // Возвращает true если объединение произошло, false - если элементы уже находятся в одном связном множестве.
     bool uniteIfNotConnected(size_t x, size_t y) {
@@ -71,4 +90,106 @@ public:
     }
 };
 
+using DisjointSet = DisjointSet_T<size_t>;
+using DisjointSet32 = DisjointSet_T<uint32_t>;
+
+// Лес непересекающихся множеств для параллельных алгоритмов. Все методы можно вызывать одновременно из разных потоков.
+// Сжатие пути - делением пополам (path halving): каждый шаг find() CAS-ом перевешивает элемент на деда,
+// что безопасно при одновременных find() и unite().
+// Объединение - CAS родителя корня, который подвешивается. Если корень уже подвесил другой поток, CAS не проходит и
+// объединение повторяется с новыми корнями. Циклы невозможны: ключ корня при подвешивании меньше ключа нового родителя,
+// а ключ корня может только расти.
+// ByRank = false: ключ - номер с обратным знаком (link by index). Представитель множества - его наименьший элемент.
+// ByRank = true: ключ - пара (ранг, номер), ранг хранится в старших битах слова родителя и меняется тем же CAS-ом.
+//   Высота деревьев O(lg(n)) при любом порядке объединений, но представитель - произвольный элемент.
+template <bool ByRank = false> class ConcurrentDisjointSet_T {
+    static constexpr unsigned RANK_SHIFT = 56; // Ранг не превосходит lg(n) < 64, ему хватает старшего байта.
+    static constexpr size_t RANK_ONE = size_t(1) << RANK_SHIFT;
+    static constexpr size_t PARENT_MASK = RANK_ONE - 1;
+
+    mutable std::vector<std::atomic<size_t>> _root; // Дерево множества - элементы корни деревьев связных множеств.
+    std::atomic<size_t> _count; // Количество множеств.
+
+    static size_t parent_(size_t word) { return ByRank ? word & PARENT_MASK : word; }
+    static size_t rank_(size_t word) { return ByRank ? word >> RANK_SHIFT : 0; }
+    // Слово с прежним рангом и новым родителем p.
+    static size_t relink_(size_t word, size_t p) { return ByRank ? (word & ~PARENT_MASK) | p : p; }
+
+public:
+    static constexpr bool concurrent = true;
+
+    ConcurrentDisjointSet_T(size_t n) : _root(n), _count(n) {
+        for (size_t i = 0; i < n; i++) {
+            _root[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Количество элементов.
+    size_t size() const { return _root.size(); }
+
+    // Количество множеств.
+    size_t count() const { return _count.load(std::memory_order_relaxed); }
+
+    // Возвращает представителя связного множества, сжимая путь делением пополам.
+    size_t find(size_t x) const {
+        for (;;) {
+            size_t word = _root[x].load(std::memory_order_relaxed);
+            size_t p = parent_(word);
+            if (p == x) return x;
+            size_t gp = parent_(_root[p].load(std::memory_order_relaxed));
+            if (p != gp) {
+                _root[x].compare_exchange_weak(word, relink_(word, gp), std::memory_order_relaxed);
+            }
+            x = gp;
+        }
+    }
+
+    // Представитель без сжатия пути: только чтение, без записи в общую память и без повторов, поэтому wait-free.
+    // Для фаз, где объединений нет, а запросов много: строки кэша не переходят между ядрами.
+    size_t findReadOnly(size_t x) const {
+        for (size_t p; (p = parent_(_root[x].load(std::memory_order_relaxed))) != x; x = p) {}
+        return x;
+    }
+
+    // Если после find() x всё ещё корень, то в этот момент x и y были в разных множествах.
+    bool isConnected(size_t x, size_t y) const {
+        for (;;) {
+            x = find(x);
+            y = find(y);
+            if (x == y) return true;
+            if (parent_(_root[x].load(std::memory_order_acquire)) == x) return false;
+        }
+    }
+
+    // Связывает два связных множества в которых находятся элементы x и y в одно.
+    // Возвращает true если объединение произошло, false - если элементы уже находятся в одном связном множестве.
+    bool uniteIfNotConnected(size_t x, size_t y) {
+        for (;;) {
+            x = find(x);
+            y = find(y);
+            if (x == y) return false;
+            size_t wx = _root[x].load(std::memory_order_acquire);
+            size_t wy = _root[y].load(std::memory_order_acquire);
+            if (parent_(wx) != x || parent_(wy) != y) continue; // Другой поток успел подвесить корень.
+            // Подвешиваем x - корень с меньшим ключом.
+            if (rank_(wx) > rank_(wy) || (rank_(wx) == rank_(wy) && (ByRank ? x > y : x < y))) {
+                std::swap(x, y);
+                std::swap(wx, wy);
+            }
+            if (_root[x].compare_exchange_strong(wx, relink_(wx, y), std::memory_order_acq_rel)) {
+                if (ByRank && rank_(wx) == rank_(wy)) {
+                    // Ранги сравнялись - повышаем ранг y. CAS не проходит, если ранг y уже изменился или y подвешен:
+                    // ранг лишь эвристика, результат верен.
+                    _root[y].compare_exchange_strong(wy, wy + RANK_ONE, std::memory_order_acq_rel);
+                }
+                _count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+};
+
+using ConcurrentDisjointSet = ConcurrentDisjointSet_T<false>;
+using ConcurrentRankDisjointSet = ConcurrentDisjointSet_T<true>;
+
 #endif /* disjointSet_h */
@@ -0,0 +1,399 @@
+//
+//  dynamicConnectivity.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Полностью динамическая связность неориентированного графа: рёбра добавляются и удаляются.
+
+#ifndef dynamicConnectivity_h
+#define dynamicConnectivity_h
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include "graphBase.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Лес эйлеровых обходов (Euler tour trees). Henzinger, King 1995.
+    // Дерево хранится как циклический эйлеров обход: по узлу на вершину и по узлу на каждую дугу (v, w) и (w, v).
+    // Обход лежит в декартовом дереве (treap) с неявным ключом - позицией в обходе, поэтому link, cut и
+    // смена корня обхода - это O(1) разрезаний и склеек по O(lg(n)) в среднем.
+    // Узлы агрегируют количество вершин поддерева и битовые флаги, по которым находится помеченная вершина или дуга
+    // дерева за O(lg(n)).
+    class EulerTourForest {
+    public:
+        static constexpr size_t NONE = size_t(-1);
+        enum Flag : uint8_t { VERTEX_FLAG = 1, ARC_FLAG = 2 };
+
+    private:
+        static constexpr uint32_t NIL = uint32_t(-1);
+
+        struct Node {
+            uint32_t l = NIL, r = NIL, p = NIL;
+            uint32_t prio;
+            uint32_t size = 1; // Кол-во узлов поддерева.
+            uint32_t vertices; // Кол-во вершин поддерева.
+            uint8_t self = 0; // Флаги узла.
+            uint8_t agg = 0; // Объединение флагов поддерева.
+        };
+
+        size_t _n; // Узлы [0, _n) - вершины, остальные - дуги.
+        vector<Node> _t;
+        vector<uint64_t> _arcKey; // Дуга узла.
+        vector<uint32_t> _free; // Освобождённые узлы дуг.
+        unordered_map<uint64_t, uint32_t> _arcs; // Узел дуги (v, w).
+        uint32_t _seed = 2463534242u;
+
+        static uint64_t key_(size_t v, size_t w) { return (uint64_t(v) << 32) | w; }
+
+        uint32_t random_() {
+            _seed ^= _seed << 13;
+            _seed ^= _seed >> 17;
+            _seed ^= _seed << 5;
+            return _seed;
+        }
+
+        uint32_t size_(uint32_t x) const { return x == NIL ? 0 : _t[x].size; }
+        uint32_t vertices_(uint32_t x) const { return x == NIL ? 0 : _t[x].vertices; }
+        uint8_t agg_(uint32_t x) const { return x == NIL ? 0 : _t[x].agg; }
+
+        void update_(uint32_t x) {
+            Node& n = _t[x];
+            n.size = 1 + size_(n.l) + size_(n.r);
+            n.vertices = (x < _n) + vertices_(n.l) + vertices_(n.r);
+            n.agg = n.self | agg_(n.l) | agg_(n.r);
+            if (n.l != NIL) _t[n.l].p = x;
+            if (n.r != NIL) _t[n.r].p = x;
+        }
+
+        uint32_t merge_(uint32_t a, uint32_t b) {
+            if (a == NIL) return b;
+            if (b == NIL) return a;
+            if (_t[a].prio > _t[b].prio) {
+                _t[a].r = merge_(_t[a].r, b);
+                update_(a);
+                return a;
+            }
+            _t[b].l = merge_(a, _t[b].l);
+            update_(b);
+            return b;
+        }
+
+        // l - первые k узлов обхода x, r - остальные.
+        void splitR_(uint32_t x, size_t k, uint32_t& l, uint32_t& r) {
+            if (x == NIL) {
+                l = r = NIL;
+                return;
+            }
+            if (size_(_t[x].l) < k) {
+                splitR_(_t[x].r, k - size_(_t[x].l) - 1, _t[x].r, r);
+                l = x;
+            } else {
+                splitR_(_t[x].l, k, l, _t[x].l);
+                r = x;
+            }
+            update_(x);
+        }
+
+        void split_(uint32_t x, size_t k, uint32_t& l, uint32_t& r) {
+            splitR_(x, k, l, r);
+            if (l != NIL) _t[l].p = NIL;
+            if (r != NIL) _t[r].p = NIL;
+        }
+
+        uint32_t root_(uint32_t x) const {
+            while (_t[x].p != NIL) x = _t[x].p;
+            return x;
+        }
+
+        // Позиция узла в обходе.
+        size_t index_(uint32_t x) const {
+            size_t k = size_(_t[x].l);
+            for (uint32_t p = _t[x].p; p != NIL; x = p, p = _t[p].p) {
+                if (_t[p].r == x) k += size_(_t[p].l) + 1;
+            }
+            return k;
+        }
+
+        // Циклический сдвиг обхода дерева вершины v так, чтобы он начинался с v.
+        uint32_t reroot_(size_t v) {
+            uint32_t a, b;
+            split_(root_(uint32_t(v)), index_(uint32_t(v)), a, b);
+            return merge_(b, a);
+        }
+
+        uint32_t newArc_(size_t v, size_t w) {
+            uint32_t x;
+            if (_free.empty()) {
+                x = uint32_t(_t.size());
+                _t.emplace_back();
+                _arcKey.push_back(0);
+            } else {
+                x = _free.back();
+                _free.pop_back();
+                _t[x] = Node();
+            }
+            _t[x].prio = random_();
+            _t[x].vertices = 0;
+            _arcKey[x] = key_(v, w);
+            _arcs[key_(v, w)] = x;
+            return x;
+        }
+
+        void freeArc_(uint32_t x) {
+            _arcs.erase(_arcKey[x]);
+            _free.push_back(x);
+        }
+
+        void setFlag_(uint32_t x, uint8_t flag, bool on) {
+            uint8_t self = on ? _t[x].self | flag : _t[x].self & ~flag;
+            if (self == _t[x].self) return;
+            _t[x].self = self;
+            for (; x != NIL; x = _t[x].p) update_(x);
+        }
+
+        // Узел с флагом в дереве вершины v.
+        uint32_t find_(size_t v, uint8_t flag) const {
+            uint32_t x = root_(uint32_t(v));
+            if (!(_t[x].agg & flag)) return NIL;
+            for (;;) {
+                if (agg_(_t[x].l) & flag) x = _t[x].l;
+                else if (_t[x].self & flag) return x;
+                else x = _t[x].r;
+            }
+        }
+
+    public:
+        EulerTourForest(size_t n) : _n(n), _t(n), _arcKey(n) {
+            assert(n < NIL / 4);
+            for (size_t v = 0; v < n; v++) {
+                _t[v].prio = random_();
+                _t[v].vertices = 1;
+            }
+        }
+
+        // Кол-во вершин
+        size_t size() const { return _n; }
+
+        bool connected(size_t v, size_t w) const { return root_(uint32_t(v)) == root_(uint32_t(w)); }
+
+        // Кол-во вершин дерева v.
+        size_t treeSize(size_t v) const { return _t[root_(uint32_t(v))].vertices; }
+
+        // Соединяет деревья вершин v и w ребром {v, w}. v и w в разных деревьях.
+        void link(size_t v, size_t w) {
+            assert(!connected(v, w));
+            uint32_t tv = reroot_(v);
+            uint32_t tw = reroot_(w);
+            uint32_t vw = newArc_(v, w), wv = newArc_(w, v);
+            uint32_t t = merge_(merge_(merge_(tv, vw), tw), wv);
+            _t[t].p = NIL;
+        }
+
+        // Удаляет ребро дерева {v, w}, разделяя дерево на два.
+        void cut(size_t v, size_t w) {
+            uint32_t a = _arcs.at(key_(v, w)), b = _arcs.at(key_(w, v));
+            size_t ia = index_(a), ib = index_(b);
+            if (ia > ib) {
+                swap(a, b);
+                swap(ia, ib);
+            }
+            // Обход: A a B b C. Остаются деревья A+C и B.
+            uint32_t left, mid, right, rest;
+            split_(root_(a), ia, left, rest);
+            split_(rest, 1, mid, rest);
+            split_(rest, ib - ia - 1, mid, right);
+            split_(right, 1, rest, right);
+            uint32_t t = merge_(left, right);
+            if (t != NIL) _t[t].p = NIL;
+            freeArc_(a);
+            freeArc_(b);
+        }
+
+        // Флаг вершины.
+        void markVertex(size_t v, bool on) { setFlag_(uint32_t(v), VERTEX_FLAG, on); }
+
+        // Флаг ребра дерева {v, w}. Хранится на дуге (v, w).
+        void markEdge(size_t v, size_t w, bool on) { setFlag_(_arcs.at(key_(v, w)), ARC_FLAG, on); }
+
+        // Помеченная вершина в дереве v или NONE.
+        size_t findVertex(size_t v) const {
+            uint32_t x = find_(v, VERTEX_FLAG);
+            return x == NIL ? NONE : x;
+        }
+
+        // Помеченное ребро {x, y} в дереве v. false если помеченных рёбер нет.
+        bool findEdge(size_t v, size_t& x, size_t& y) const {
+            uint32_t a = find_(v, ARC_FLAG);
+            if (a == NIL) return false;
+            x = size_t(_arcKey[a] >> 32);
+            y = size_t(_arcKey[a] & 0xffffffff);
+            return true;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Полностью динамическая связность. Holm, de Lichtenberg, Thorup 2001.
+    // insert/remove амортизированно O(lg^2(V)), connected O(lg(V)).
+    // Каждое ребро имеет уровень 0..lg(V), уровень только растёт. F_i - остовный лес рёбер уровня >= i, F_0 - остовный
+    // лес графа, F_0 ⊇ F_1 ⊇ ... Инвариант: дерево F_i содержит не больше V/2^i вершин.
+    // При удалении ребра дерева уровня l ищется замена на уровнях l..0: на уровне i меньшая половина разрезанного
+    // дерева поднимает свои рёбра дерева уровня i на i+1, затем перебираются нерёберные (non-tree) рёбра уровня i
+    // этой половины. Ребро, ведущее в другую половину - замена, остальные поднимаются на i+1.
+    // Подъёмы и оплачивают амортизированную оценку: каждое ребро поднимается не больше lg(V) раз.
+    // Заменяет пересчёт CC_T после каждого удаления ребра из SparseGraph_T.
+    class DynamicConnectivity {
+        struct EdgeInfo {
+            uint8_t level;
+            bool tree;
+        };
+
+        size_t _n;
+        size_t _count; // Количество компонент.
+        vector<EulerTourForest> _forest; // F_i.
+        vector<unordered_map<size_t, unordered_set<size_t>>> _nontree; // Нерёберные смежности уровня i.
+        unordered_map<uint64_t, EdgeInfo> _edges;
+
+        static uint64_t key_(size_t v, size_t w) {
+            if (v > w) swap(v, w);
+            return (uint64_t(v) << 32) | w;
+        }
+
+        // Лес уровня i создаётся при первом подъёме ребра на уровень i.
+        EulerTourForest& forest_(size_t i) {
+            while (_forest.size() <= i) {
+                _forest.emplace_back(_n);
+                _nontree.emplace_back();
+            }
+            return _forest[i];
+        }
+
+        void addNontree_(size_t v, size_t w, size_t i) {
+            auto& adj = _nontree[i];
+            for (auto [x, y] : {pair<size_t, size_t>(v, w), pair<size_t, size_t>(w, v)}) {
+                auto& set = adj[x];
+                if (set.empty()) _forest[i].markVertex(x, true);
+                set.insert(y);
+            }
+        }
+
+        void removeNontree_(size_t v, size_t w, size_t i) {
+            auto& adj = _nontree[i];
+            for (auto [x, y] : {pair<size_t, size_t>(v, w), pair<size_t, size_t>(w, v)}) {
+                auto it = adj.find(x);
+                it->second.erase(y);
+                if (it->second.empty()) {
+                    adj.erase(it);
+                    _forest[i].markVertex(x, false);
+                }
+            }
+        }
+
+        // Ребро дерева уровня i входит в F_0..F_i, помечено в F_i.
+        void addTree_(size_t v, size_t w, size_t i) {
+            for (size_t j = 0; j <= i; j++) _forest[j].link(v, w);
+            _forest[i].markEdge(min(v, w), max(v, w), true);
+        }
+
+        // Поиск замены удалённого ребра дерева {v, w} уровня level. Возвращает false если её нет.
+        bool replace_(size_t v, size_t w, size_t level) {
+            forest_(level + 1);
+            for (size_t i = level + 1; i-- > 0;) {
+                EulerTourForest& f = _forest[i];
+                if (f.treeSize(v) > f.treeSize(w)) swap(v, w);
+
+                // 1. Рёбра дерева уровня i меньшей половины поднимаются на i+1.
+                for (size_t x, y; f.findEdge(v, x, y);) {
+                    f.markEdge(x, y, false);
+                    _edges[key_(x, y)].level = uint8_t(i + 1);
+                    _forest[i + 1].link(x, y);
+                    _forest[i + 1].markEdge(x, y, true);
+                }
+
+                // 2. Нерёберные рёбра уровня i меньшей половины: замена или подъём на i+1.
+                for (size_t x; (x = f.findVertex(v)) != EulerTourForest::NONE;) {
+                    size_t y = *_nontree[i].at(x).begin();
+                    removeNontree_(x, y, i);
+                    EdgeInfo& e = _edges[key_(x, y)];
+                    if (f.connected(y, w)) {
+                        e.tree = true;
+                        addTree_(x, y, i);
+                        return true;
+                    }
+                    e.level = uint8_t(i + 1);
+                    addNontree_(x, y, i + 1);
+                }
+            }
+            return false;
+        }
+
+    public:
+        DynamicConnectivity(size_t n) : _n(n), _count(n) {
+            trace("DynamicConnectivity");
+            forest_(0);
+        }
+
+        // Связность графа g, дальше рёбра добавляются и удаляются.
+        template <class G, class = typename G::Traits> DynamicConnectivity(const G& g) : DynamicConnectivity(g.size()) {
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) insert(v, w);
+            }
+        }
+
+        // Кол-во вершин
+        size_t size() const { return _n; }
+
+        // Кол-во ребер
+        size_t edgesCount() const { return _edges.size(); }
+
+        // Количество компонент связности.
+        size_t count() const { return _count; }
+
+        bool edge(size_t v, size_t w) const { return _edges.count(key_(v, w)) != 0; }
+
+        bool connected(size_t v, size_t w) const { return _forest[0].connected(v, w); }
+
+        // Количество вершин в компоненте v.
+        size_t componentSize(size_t v) const { return _forest[0].treeSize(v); }
+
+        // Добавляет ребро {v, w}. Петли и повторные рёбра игнорируются, тогда возвращает false.
+        bool insert(size_t v, size_t w) {
+            if (v == w) return false;
+            auto [it, inserted] = _edges.insert({key_(v, w), EdgeInfo{0, false}});
+            if (!inserted) return false;
+            if (!_forest[0].connected(v, w)) {
+                it->second.tree = true;
+                addTree_(v, w, 0);
+                _count--;
+            } else {
+                addNontree_(v, w, 0);
+            }
+            return true;
+        }
+
+        // Удаляет ребро {v, w}. Возвращает false, если ребра нет.
+        bool remove(size_t v, size_t w) {
+            auto it = _edges.find(key_(v, w));
+            if (it == _edges.end()) return false;
+            EdgeInfo e = it->second;
+            _edges.erase(it);
+            if (!e.tree) {
+                removeNontree_(v, w, e.level);
+                return true;
+            }
+            _forest[e.level].markEdge(min(v, w), max(v, w), false);
+            for (size_t j = 0; j <= e.level; j++) _forest[j].cut(v, w);
+            if (!replace_(v, w, e.level)) _count++;
+            return true;
+        }
+    };
+}
+
+#endif /* dynamicConnectivity_h */
@@ -0,0 +1,360 @@
+//
+//  heap.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Очереди с приоритетом вершин для поиска по приоритету (Дейкстра, Прим).
+
+#ifndef heap_h
+#define heap_h
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <assert.h>
+
+namespace Graph {
+
+    // Общий интерфейс очередей - политик SptDijkstra_T. Элементы - вершины [0, n), у каждой вершины не больше одного ключа:
+    // - push(v, key) - вставка v или уменьшение её ключа, если key меньше текущего;
+    // - pop() - извлечение вершины с наименьшим ключом;
+    // - empty(), size(), contains(v), clear() - clear() за O(size()), вершины вне очереди не трогаются.
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Ленивая очередь на std::priority_queue: уменьшение ключа - повторная вставка, устаревшие записи
+    // пропускаются при извлечении. Ключ хранится в записи, поэтому порядок кучи не зависит от внешних массивов.
+    // Размер очереди до O(E).
+    template <class Key> class LazyQueue_T {
+        using Entry = std::pair<Key, size_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> _queue;
+        std::vector<Key> _key; // Текущий ключ вершины в очереди.
+        std::vector<bool> _in;
+        size_t _size = 0;
+
+    public:
+        explicit LazyQueue_T(size_t n = 0) : _key(n), _in(n) {}
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        bool contains(size_t v) const { return _in[v]; }
+
+        void push(size_t v, Key key) {
+            if (_in[v]) {
+                if (!(key < _key[v])) return;
+            } else {
+                _in[v] = true;
+                _size++;
+            }
+            _key[v] = key;
+            _queue.push({key, v});
+        }
+
+        size_t pop() {
+            for (;;) {
+                Entry e = _queue.top(); _queue.pop();
+                if (_in[e.second] && e.first == _key[e.second]) {
+                    _in[e.second] = false;
+                    _size--;
+                    return e.second;
+                }
+            }
+        }
+
+        void clear() {
+            for (; !_queue.empty(); _queue.pop()) _in[_queue.top().second] = false;
+            _size = 0;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Индексная D-ичная куча. Позиция каждой вершины в куче известна, поэтому уменьшение ключа - подъём на месте
+    // за O(log_D(V)), а размер кучи не больше V. D = 4: дерево ниже двоичного, а 4 потомка с ключами лежат
+    // в одной-двух строках кэша.
+    template <class Key, size_t D = 4> class DaryHeap_T {
+        static_assert(D >= 2, "DaryHeap_T requires D >= 2");
+        static constexpr size_t NONE = size_t(-1);
+
+        struct Entry {
+            Key key;
+            size_t v;
+        };
+        std::vector<Entry> _heap;
+        std::vector<size_t> _pos; // Позиция вершины в куче или NONE.
+
+        void place_(size_t i, const Entry& e) {
+            _heap[i] = e;
+            _pos[e.v] = i;
+        }
+
+        void up_(size_t i) {
+            const Entry e = _heap[i];
+            while (i > 0) {
+                size_t p = (i - 1) / D;
+                if (!(e.key < _heap[p].key)) break;
+                place_(i, _heap[p]);
+                i = p;
+            }
+            place_(i, e);
+        }
+
+        void down_(size_t i) {
+            const Entry e = _heap[i];
+            const size_t n = _heap.size();
+            for (;;) {
+                size_t first = i * D + 1;
+                if (first >= n) break;
+                size_t last = std::min(first + D, n);
+                size_t m = first;
+                for (size_t c = first + 1; c < last; c++) {
+                    if (_heap[c].key < _heap[m].key) m = c;
+                }
+                if (!(_heap[m].key < e.key)) break;
+                place_(i, _heap[m]);
+                i = m;
+            }
+            place_(i, e);
+        }
+
+    public:
+        explicit DaryHeap_T(size_t n = 0) : _pos(n, NONE) {}
+
+        bool empty() const { return _heap.empty(); }
+        size_t size() const { return _heap.size(); }
+        bool contains(size_t v) const { return _pos[v] != NONE; }
+
+        void push(size_t v, Key key) {
+            size_t i = _pos[v];
+            if (i == NONE) {
+                _heap.push_back({key, v});
+                up_(_heap.size() - 1);
+            } else if (key < _heap[i].key) {
+                _heap[i].key = key;
+                up_(i);
+            }
+        }
+
+        size_t pop() {
+            const size_t v = _heap[0].v;
+            _pos[v] = NONE;
+            const Entry last = _heap.back();
+            _heap.pop_back();
+            if (!_heap.empty()) {
+                _heap[0] = last;
+                down_(0);
+            }
+            return v;
+        }
+
+        void clear() {
+            for (const Entry& e : _heap) _pos[e.v] = NONE;
+            _heap.clear();
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Парная куча. Fredman, Sedgewick, Sleator, Tarjan 1986.
+    // Узлы - сами вершины. Вставка и уменьшение ключа - O(1): поддерево вершины отрезается и сливается с корнем.
+    // Извлечение - двухпроходное попарное слияние потомков корня, O(lg(V)) амортизированно.
+    template <class Key> class PairingHeap_T {
+        static constexpr size_t NONE = size_t(-1);
+
+        struct Node {
+            Key key;
+            size_t child = NONE, next = NONE;
+            size_t prev = NONE; // Левый брат или родитель для первого потомка.
+            bool in = false;
+        };
+        std::vector<Node> _nodes;
+        size_t _root = NONE;
+        size_t _size = 0;
+        std::vector<size_t> _pairs;
+
+        // Слияние двух корней. Возвращает новый корень.
+        size_t meld_(size_t a, size_t b) {
+            if (a == NONE) return b;
+            if (b == NONE) return a;
+            if (_nodes[b].key < _nodes[a].key) std::swap(a, b);
+            Node& na = _nodes[a];
+            Node& nb = _nodes[b];
+            nb.prev = a;
+            nb.next = na.child;
+            if (na.child != NONE) _nodes[na.child].prev = b;
+            na.child = b;
+            na.next = na.prev = NONE;
+            return a;
+        }
+
+        // Отрезание поддерева v от родителя.
+        void cut_(size_t v) {
+            Node& n = _nodes[v];
+            Node& p = _nodes[n.prev];
+            if (p.child == v) p.child = n.next;
+            else p.next = n.next;
+            if (n.next != NONE) _nodes[n.next].prev = n.prev;
+            n.next = n.prev = NONE;
+        }
+
+    public:
+        explicit PairingHeap_T(size_t n = 0) : _nodes(n) {}
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        bool contains(size_t v) const { return _nodes[v].in; }
+
+        void push(size_t v, Key key) {
+            Node& n = _nodes[v];
+            if (!n.in) {
+                n.key = key;
+                n.in = true;
+                n.child = n.next = n.prev = NONE;
+                _size++;
+                _root = meld_(_root, v);
+            } else if (key < n.key) {
+                n.key = key;
+                if (v != _root) {
+                    cut_(v);
+                    _root = meld_(_root, v);
+                }
+            }
+        }
+
+        size_t pop() {
+            const size_t v = _root;
+            Node& n = _nodes[v];
+            n.in = false;
+            _size--;
+            // Первый проход: слияние потомков парами слева направо.
+            _pairs.clear();
+            for (size_t c = n.child; c != NONE; ) {
+                size_t a = c, b = _nodes[a].next;
+                c = b != NONE ? _nodes[b].next : NONE;
+                _nodes[a].next = _nodes[a].prev = NONE;
+                if (b != NONE) _nodes[b].next = _nodes[b].prev = NONE;
+                _pairs.push_back(meld_(a, b));
+            }
+            // Второй проход: слияние пар справа налево.
+            size_t root = NONE;
+            for (size_t i = _pairs.size(); i-- > 0; ) root = meld_(_pairs[i], root);
+            _root = root;
+            n.child = NONE;
+            return v;
+        }
+
+        void clear() {
+            // Обход всех узлов дерева от корня.
+            _pairs.clear();
+            if (_root != NONE) _pairs.push_back(_root);
+            while (!_pairs.empty()) {
+                size_t v = _pairs.back(); _pairs.pop_back();
+                Node& n = _nodes[v];
+                if (n.child != NONE) _pairs.push_back(n.child);
+                if (n.next != NONE) _pairs.push_back(n.next);
+                n.in = false;
+                n.child = n.next = n.prev = NONE;
+            }
+            _root = NONE;
+            _size = 0;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Поразрядная (radix) куча. Ahuja, Mehlhorn, Orlin, Tarjan 1990.
+    // Монотонная очередь: извлекаемые ключи не убывают, что верно для Дейкстры с неотрицательными весами.
+    // Ключ переводится в 64-битное число с тем же порядком (для неотрицательных float/double - их битовое представление).
+    // Корзина i хранит ключи, у которых старший отличающийся от последнего извлечённого ключа бит - i-й.
+    // При извлечении из пустой корзины 0 наименьшая непустая корзина раскладывается по младшим, каждый ключ
+    // опускается не больше 64 раз: O(lg(C)) амортизированно на операцию. Уменьшение ключа - ленивая повторная вставка.
+    template <class Key> class RadixHeap_T {
+        static_assert(std::is_arithmetic<Key>::value, "RadixHeap_T requires arithmetic keys");
+        static constexpr size_t BUCKETS = 65;
+
+        struct Entry {
+            uint64_t rkey;
+            size_t v;
+        };
+        std::vector<Entry> _buckets[BUCKETS];
+        std::vector<uint64_t> _key; // Текущий ключ вершины в очереди.
+        std::vector<bool> _in;
+        uint64_t _last = 0; // Последний извлечённый ключ.
+        size_t _size = 0;
+
+        static uint64_t radix_(Key key) {
+            if (std::is_floating_point<Key>::value) {
+                assert(!(key < 0));
+                double d = double(key) + 0.; // -0. -> +0.
+                uint64_t r;
+                std::memcpy(&r, &d, sizeof(r));
+                return r;
+            }
+            return uint64_t(key);
+        }
+
+        static size_t bucket_(uint64_t rkey, uint64_t last) {
+            return rkey == last ? 0 : 64 - __builtin_clzll(rkey ^ last);
+        }
+
+        bool valid_(const Entry& e) const { return _in[e.v] && _key[e.v] == e.rkey; }
+
+    public:
+        explicit RadixHeap_T(size_t n = 0) : _key(n), _in(n) {}
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        bool contains(size_t v) const { return _in[v]; }
+
+        void push(size_t v, Key key) {
+            const uint64_t r = radix_(key);
+            assert(r >= _last);
+            if (_in[v]) {
+                if (r >= _key[v]) return;
+            } else {
+                _in[v] = true;
+                _size++;
+            }
+            _key[v] = r;
+            _buckets[bucket_(r, _last)].push_back({r, v});
+        }
+
+        size_t pop() {
+            for (;;) {
+                if (_buckets[0].empty()) {
+                    size_t i = 1;
+                    while (_buckets[i].empty()) i++;
+                    // Новый последний ключ - наименьший действительный в корзине i.
+                    auto& b = _buckets[i];
+                    uint64_t m = uint64_t(-1);
+                    for (const Entry& e : b) if (valid_(e) && e.rkey < m) m = e.rkey;
+                    if (m != uint64_t(-1)) {
+                        _last = m;
+                        for (const Entry& e : b) if (valid_(e)) _buckets[bucket_(e.rkey, _last)].push_back(e);
+                    }
+                    b.clear();
+                    continue;
+                }
+                Entry e = _buckets[0].back(); _buckets[0].pop_back();
+                if (valid_(e)) {
+                    _in[e.v] = false;
+                    _size--;
+                    return e.v;
+                }
+            }
+        }
+
+        void clear() {
+            for (auto& b : _buckets) {
+                for (const Entry& e : b) _in[e.v] = false;
+                b.clear();
+            }
+            _last = 0;
+            _size = 0;
+        }
+    };
+}
+
+#endif /* heap_h */
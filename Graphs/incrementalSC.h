@@ -0,0 +1,194 @@
+//
+//  incrementalSC.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сильные компоненты орграфа, в который добавляются рёбра.
+
+#ifndef incrementalSC_h
+#define incrementalSC_h
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "graphBase.h"
+#include "disjointSet.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Инкрементальные сильные компоненты. Pearce, Kelly 2006 с объединением компонент (Haeupler et al. 2012).
+    // Компоненты - множества DisjointSet, вершины конденсации - их представители в топологическом порядке ord.
+    // Вставка v->w между компонентами cv и cw:
+    // - ord[cv] < ord[cw] - порядок не нарушен, O(1);
+    // - иначе в окне [ord[cw], ord[cv]] ищутся F - компоненты, достижимые из cw, и B - компоненты, из которых достижима cv.
+    //   Если cv в F, ребро замкнуло цикл: компоненты F ∩ B сливаются в одну. Позиции F и B раздаются заново:
+    //   B \ F, затем слитая компонента, затем F \ B на старших позициях. Лишние позиции слитых компонент пустеют.
+    // Списки смежности хранятся у представителей и сливаются вместе с компонентами, рёбра внутри компонент выбрасываются.
+    // Стоимость вставки O(δ lg δ), где δ - компоненты F и B вместе с их рёбрами. При почти согласованных с порядком
+    // вставках (граф зависимостей) окна малы; при случайном порядке вставок δ растёт до O(V + E), как и у пересчёта.
+    // Запросы id(v), connected(v, w) - O(α(V)) амортизированно.
+    class IncrementalSC {
+        DisjointSet _ds;
+        vector<vector<size_t>> _out, _in; // Рёбра компонент, действительны для представителей.
+        vector<size_t> _ord; // Позиция компоненты в топологическом порядке конденсации.
+        size_t _ordCnt = 0; // Следующая свободная позиция.
+        size_t _edges = 0;
+        vector<uint32_t> _seenF, _seenB; // Эпоха попадания компоненты в F и в B.
+        uint32_t _epoch = 0;
+        vector<size_t> _stack, _forward, _backward, _positions;
+
+        uint32_t nextEpoch_() {
+            if (++_epoch == 0) {
+                fill(_seenF.begin(), _seenF.end(), 0);
+                fill(_seenB.begin(), _seenB.end(), 0);
+                _epoch = 1;
+            }
+            return _epoch;
+        }
+
+        void resize_(size_t n) {
+            _ds.resize(n);
+            _out.resize(n);
+            _in.resize(n);
+            _seenF.resize(n);
+            _seenB.resize(n);
+            while (_ord.size() < n) _ord.push_back(_ordCnt++);
+        }
+
+        // Обход компонент из c по спискам adj в окне ord. Рёбра внутри компонент удаляются по пути.
+        template <class InWindow>
+        void search_(vector<vector<size_t>>& adj, size_t c, vector<uint32_t>& seen, vector<size_t>& result, InWindow inWindow) {
+            const uint32_t epoch = _epoch;
+            result.clear();
+            _stack.assign(1, c);
+            seen[c] = epoch;
+            while (!_stack.empty()) {
+                size_t x = _stack.back(); _stack.pop_back();
+                result.push_back(x);
+                auto& l = adj[x];
+                for (size_t i = 0; i < l.size(); ) {
+                    size_t y = _ds.find(l[i]);
+                    if (y == x) {
+                        l[i] = l.back();
+                        l.pop_back();
+                        continue;
+                    }
+                    if (seen[y] != epoch && inWindow(_ord[y])) {
+                        seen[y] = epoch;
+                        _stack.push_back(y);
+                    }
+                    i++;
+                }
+            }
+        }
+
+        // Слияние компонент M = F ∩ B. Возвращает представителя.
+        size_t merge_(const vector<size_t>& m) {
+            for (size_t x : m) _ds.uniteIfNotConnected(m[0], x);
+            const size_t r = _ds.find(m[0]);
+            // Сливаем списки в самый длинный, оставляя только рёбра наружу.
+            auto mergeLists = [&](vector<vector<size_t>>& adj) {
+                size_t largest = r;
+                for (size_t x : m) if (adj[x].size() > adj[largest].size()) largest = x;
+                if (largest != r) adj[r].swap(adj[largest]);
+                auto& l = adj[r];
+                l.erase(remove_if(l.begin(), l.end(), [&](size_t y) { return _ds.find(y) == r; }), l.end());
+                for (size_t x : m) {
+                    if (x == r) continue;
+                    for (size_t y : adj[x]) if (_ds.find(y) != r) l.push_back(y);
+                    vector<size_t>().swap(adj[x]);
+                }
+            };
+            mergeLists(_out);
+            mergeLists(_in);
+            return r;
+        }
+
+    public:
+        IncrementalSC(size_t vertices = 0) { trace("IncrementalSC"); resize_(vertices); }
+
+        template <class G, class = typename G::Traits> IncrementalSC(const G& g) {
+            trace("IncrementalSC");
+            resize_(g.size());
+            for (size_t v = 0; v < g.size(); v++)
+                for (size_t w : g.adjacent(v)) insert(v, w);
+        }
+
+        // Количество вершин.
+        size_t size() const { return _ds.size(); }
+        size_t edgesCount() const { return _edges; }
+
+        // Количество сильных компонент.
+        size_t count() const { return _ds.count(); }
+
+        // Граф ацикличен: все компоненты одиночные.
+        bool acyclic() const { return count() == size(); }
+
+        // Вставка ребра v->w. Недостающие вершины добавляются.
+        // Возвращает true, если ребро замкнуло цикл и компоненты слились.
+        bool insert(size_t v, size_t w) {
+            if (max(v, w) >= size()) resize_(max(v, w) + 1);
+            _edges++;
+            const size_t cv = _ds.find(v), cw = _ds.find(w);
+            if (cv == cw) return false;
+            const size_t lb = _ord[cw], ub = _ord[cv];
+            if (lb > ub) {
+                _out[cv].push_back(w);
+                _in[cw].push_back(v);
+                return false;
+            }
+
+            nextEpoch_();
+            search_(_out, cw, _seenF, _forward, [ub](size_t o) { return o <= ub; });
+            search_(_in, cv, _seenB, _backward, [lb](size_t o) { return o >= lb; });
+            const bool cycle = _seenF[cv] == _epoch;
+
+            auto byOrd = [&](size_t a, size_t b) { return _ord[a] < _ord[b]; };
+            _positions.clear();
+            for (size_t x : _forward) _positions.push_back(_ord[x]);
+            for (size_t x : _backward) if (_seenF[x] != _epoch) _positions.push_back(_ord[x]);
+            sort(_positions.begin(), _positions.end());
+
+            vector<size_t> m;
+            if (cycle) {
+                // Компоненты на путях cw -> cv - в обоих множествах.
+                for (size_t x : _forward) if (_seenB[x] == _epoch) m.push_back(x);
+                auto inM = [&](size_t x) { return _seenF[x] == _epoch && _seenB[x] == _epoch; };
+                _forward.erase(remove_if(_forward.begin(), _forward.end(), inM), _forward.end());
+                _backward.erase(remove_if(_backward.begin(), _backward.end(), inM), _backward.end());
+            }
+            sort(_forward.begin(), _forward.end(), byOrd);
+            sort(_backward.begin(), _backward.end(), byOrd);
+            // F \ B занимает старшие позиции, как в исходном алгоритме: вершины окна вне F и B, ведущие в F,
+            // остаются перед ней. Слитая компонента связана только с B и F и встаёт сразу за B \ F.
+            size_t i = 0;
+            for (size_t x : _backward) _ord[x] = _positions[i++];
+            if (cycle) _ord[merge_(m)] = _positions[i];
+            i = _positions.size() - _forward.size();
+            for (size_t x : _forward) _ord[x] = _positions[i++];
+
+            if (!cycle) {
+                _out[cv].push_back(w);
+                _in[cw].push_back(v);
+            }
+            return cycle;
+        }
+
+        // Представитель сильной компоненты вершины. Меняется при слиянии компонент.
+        size_t id(size_t v) const { return _ds.find(v); }
+        bool connected(size_t v, size_t w) const { return _ds.isConnected(v, w); }
+
+        // Количество вершин в сильной компоненте v.
+        size_t componentSize(size_t v) const { return _ds.setSize(v); }
+
+        // Компонента v предшествует компоненте w в топологическом порядке конденсации.
+        // Путь v -> w между разными компонентами возможен только при true.
+        bool precedes(size_t v, size_t w) const { return _ord[id(v)] < _ord[id(w)]; }
+    };
+}
+
+#endif /* incrementalSC_h */
@@ -23,6 +23,14 @@
 #include "spAll.h"
 #include "spAllDag.h"
 #include "maxFlow.h"
+#include "msBFS.h"
+#include "parallelCC.h"
+#include "parallelSC.h"
+#include "biconnected.h"
+#include "matching.h"
+#include "connectivity.h"
+#include "incrementalSC.h"
+#include "reachability.h"
 
 using namespace std;
 using namespace Graph;
@@ -193,6 +201,12 @@ template <class G> void testGraph(G& g) {
     cout << endl << cc.size() << " connected components\n";
 	SCTrace(cout, cc);
 	
+    auto cca = CCAfforest(g);
+    cout << cca.size() << " connected components Afforest\n";
+    Connectivity32 conn(g);
+    cout << conn.count() << " connected components incremental, component of 0: " << conn.componentSize(0) << " vertices\n";
+    SCTrace(cout, cca);
+	
 	auto bi = BI(g);
 	traverse(g, bi);
 	cout << endl << bi.bipartite() << " bipartite status\n\n";
@@ -215,6 +229,15 @@ void testGraphs() {
 	testSparseGraph();
 }
 
+void testMatching() {
+    SparseGraph g(13);
+    buildBiGraph(g);
+    auto hk = hopcroftKarp(g);
+    cout << "Max matching Hopcroft-Karp: " << hk.size() << endl;
+    for (auto e : hk.matching()) cout << "[" << e.v << ", " << e.w << "]\n";
+    cout << "Min vertex cover: " << hk.minVertexCover();
+}
+
 void testBrisgesJoints() {
     SparseGraph sg(13);
     
@@ -225,6 +248,13 @@ void testBrisgesJoints() {
     auto bridges1 = Bridges(sg, et);
     et.reset();
     auto joints1 = ArtPoints(sg, et);
+    
+    auto bc = biconnected(sg);
+    cout << "Bridges Tarjan-Vishkin:\n";
+    for (auto e : bc.bridges()) cout << "[" << e.v << ", " << e.w << "]\n";
+    cout << "ArtPoints Tarjan-Vishkin: " << bc.artPoints();
+    auto bct = blockCutTree(bc);
+    cout << "Removing 4 disconnects 3 from 9: " << bct.separates(4, 3, 9) << endl;
     return;
 //    et.reset();
 	
@@ -247,6 +277,7 @@ template <class G> void testDirGraph(G& g) {
 //    auto tc2 = TCW(g).getTC();
 //    cout << "Transitive closure Warshall:\n" << tc2;
 //    cout << "Transitive closure Warshall2:\n" << TCW(tc2).getTC();
+    cout << "BiBFS path 0-12: " << biBFS(g).path(0, 12);
     auto tc = TC(g).getTC();
     cout << "Transitive closure DFS:\n" << tc;
 	auto tcsc = TCSC(g);
@@ -262,9 +293,18 @@ template <class G> void testDirGraph(G& g) {
     
     auto tssq = TSSQ(g);
     cout << "TSSQ\n";
-    cout << "indices: [ 0  1  2  3  4  5  6  7  8  9 10 11 12]\n";
-    cout << "topolog: " << ts.ts();
-    cout << "relabel: " << ts.relabel();
+    if( tssq.isDAG() ) {
+        cout << "indices: [ 0  1  2  3  4  5  6  7  8  9 10 11 12]\n";
+        cout << "topolog: " << tssq.ts();
+        cout << "relabel: " << tssq.relabel();
+    }
+    
+    auto tsp = TSPar(g);
+    cout << "TSPar levels: " << tsp.levels() << endl;
+    for ( size_t i = 0; i < tsp.levels(); i++ ) {
+        for ( size_t v : tsp.level(i) ) cout << v << " ";
+        cout << endl;
+    }
     
     auto sc = CC(g);
     SCTrace(cout, sc);
@@ -272,6 +312,10 @@ template <class G> void testDirGraph(G& g) {
     SCTrace(cout, scTar);
     auto scGab = SCGab(g);
     SCTrace(cout, scGab);
+    auto scPar = SCPar(g);
+    SCTrace(cout, scPar);
+    IncrementalSC isc(g);
+    cout << isc.count() << " strong components incremental\n";
 }
 
 void testDenseDirGraph() {
@@ -369,6 +413,15 @@ void  testWeightedDirGraphs()
     testSparseWeightedDirGraph();
 }
 
+void testMSBFS() {
+    SparseGraph g(8);
+    buildGraph(g);
+    cout << g << "MSBFS distances from 0, 3, 7:\n";
+    for (auto& row : msBFS(g).distances({0, 3, 7})) {
+        cout << row;
+    }
+}
+
 void test_k_neighbourGraph() {
     const size_t N = 50000;
     SparseGraph g(N);
@@ -376,10 +429,12 @@ void test_k_neighbourGraph() {
 //    cout << g;
     size_t from = 0;
     size_t to = N/2;
-    auto pathCount = countBFS(g);
+    auto pathCount = countBFS<WideCount>(g);
     ofstream ofs("out.txt");
     ofs << g;
     cout << "count of shortest paths from " << from << " to " << to << " is " << pathCount.solve(from, to);
+    auto biPathCount = countBiBFS<WideCount>(g);
+    cout << "\nbidirectional: " << biPathCount.solve(from, to) << ", distance " << biPathCount.distance() << endl;
 }
 
 int main(int argc, const char * argv[]) {
@@ -389,10 +444,21 @@ int main(int argc, const char * argv[]) {
 //   testGraphs();
 //    testDirGraphs();
 //    test_k_neighbourGraph();
+//    testMSBFS();
+//    testMatching();
 //    testWeightedGraphs();
 //    testWeightedDirGraphs();
 //    spAllTest();
 //    spAllDagTest();
+//    tcBenchmark();
+//    sptTest();
+//    sptBenchmark();
+//    connectivityTest();
+//    reachabilityTest();
+//    scTest();
+//    dagTest();
+//    searchTest();
+//    matchingTest();
     maxFlowTest();
 	
     return 0;
@@ -0,0 +1,194 @@
+//
+//  matching.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Максимальное паросочетание в двудольном графе.
+
+#ifndef matching_h
+#define matching_h
+
+#include <vector>
+#include <queue>
+#include "graphBase.h"
+#include "csrGraph.h"
+#include "searchGraph.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Алгоритм Хопкрофта-Карпа. Hopcroft, Karp 1973. O(E*sqrt(V)).
+    // Паросочетание (matching) - множество рёбер без общих вершин.
+    // Увеличивающий путь - чередующийся путь между свободными вершинами разных долей: рёбра вне паросочетания и в нём.
+    // Каждая фаза: BFS из свободных вершин левой доли строит слои по длине кратчайших увеличивающих путей,
+    // затем DFS по слоям находит максимальное множество непересекающихся кратчайших увеличивающих путей.
+    // Фаз O(sqrt(V)), каждая O(E).
+    // Доли задаются раскраской BI_T или явно. Начальное паросочетание строится жадно.
+    // По теореме Кёнига минимальное вершинное покрытие имеет размер максимального паросочетания.
+    template <class G> class HopcroftKarp_T {
+        static_assert(!G::Traits::directed, "HopcroftKarp_T requires undirected graph");
+        using Adj = CSRGraph_T<GraphTraits>;
+
+        Adj _adj; // копия списков смежности с доступом по индексу.
+        vector<bool> _left; // принадлежность вершины левой доле.
+        vector<size_t> _mate; // пара вершины в паросочетании, -1 - свободна.
+        vector<size_t> _layer; // слой вершины левой доли в фазе.
+        vector<size_t> _arc; // текущее ребро DFS вершины левой доли.
+        size_t _limit = 0; // слой, из которого достижима свободная вершина правой доли: длина кратчайших увеличивающих путей.
+        size_t _size = 0;
+        static constexpr size_t NONE = -1;
+
+        void greedy_() {
+            for (size_t u = 0; u < _adj.size(); u++) {
+                if (!_left[u] || _mate[u] != NONE) continue;
+                for (size_t w : _adj.adjacent(u)) {
+                    if (!_left[w] && _mate[w] == NONE) {
+                        _mate[u] = w;
+                        _mate[w] = u;
+                        _size++;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Слои BFS от свободных вершин левой доли до первого слоя, смежного со свободной вершиной правой доли.
+        // Возвращает true, если найден увеличивающий путь.
+        bool bfs_() {
+            queue<size_t> q;
+            for (size_t u = 0; u < _adj.size(); u++) {
+                if (_left[u] && _mate[u] == NONE) {
+                    _layer[u] = 0;
+                    q.push(u);
+                } else {
+                    _layer[u] = NONE;
+                }
+            }
+            _limit = NONE;
+            while (!q.empty()) {
+                size_t u = q.front(); q.pop();
+                if (_layer[u] > _limit) break; // Слои за кратчайшими путями не нужны.
+                for (size_t w : _adj.adjacent(u)) {
+                    if (_left[w]) continue;
+                    size_t m = _mate[w];
+                    if (m == NONE) {
+                        if (_limit == NONE) _limit = _layer[u];
+                    } else if (_layer[m] == NONE && _layer[u] < _limit) {
+                        _layer[m] = _layer[u] + 1;
+                        q.push(m);
+                    }
+                }
+            }
+            return _limit != NONE;
+        }
+
+        // Поиск кратчайшего увеличивающего пути из u по слоям. Свободная вершина правой доли принимается
+        // только из последнего слоя _limit.
+        bool dfs_(size_t u) {
+            auto adj = _adj.adjacent(u);
+            for (size_t& i = _arc[u]; i < adj.size(); i++) {
+                size_t w = adj[i];
+                if (_left[w]) continue;
+                size_t m = _mate[w];
+                if (m == NONE ? _layer[u] == _limit : (_layer[u] < _limit && _layer[m] == _layer[u] + 1 && dfs_(m))) {
+                    _mate[u] = w;
+                    _mate[w] = u;
+                    return true;
+                }
+            }
+            _layer[u] = NONE; // Тупик. Больше в этой фазе не заходим.
+            return false;
+        }
+
+        void solve_(bool greedy) {
+            trace("HopcroftKarp_T");
+            if (greedy) greedy_();
+            while (bfs_()) {
+                _arc.assign(_adj.size(), 0);
+                for (size_t u = 0; u < _adj.size(); u++) {
+                    if (_left[u] && _mate[u] == NONE && dfs_(u)) _size++;
+                }
+            }
+        }
+
+    public:
+        // Доли по раскраске BI_T: левая доля - вершины цвета true.
+        HopcroftKarp_T(const G& g, const BI_T<G>& bi, bool greedy = true) : _adj(g), _left(g.size()),
+            _mate(g.size(), NONE), _layer(g.size()), _arc(g.size())
+        {
+            for (size_t v = 0; v < g.size(); v++) _left[v] = bi.color(v);
+            solve_(greedy);
+        }
+
+        // Явно заданная левая доля.
+        HopcroftKarp_T(const G& g, const vector<bool>& left, bool greedy = true) : _adj(g), _left(left),
+            _mate(g.size(), NONE), _layer(g.size()), _arc(g.size())
+        {
+            assert(left.size() == g.size());
+            solve_(greedy);
+        }
+
+        // Количество рёбер максимального паросочетания.
+        size_t size() const { return _size; }
+
+        // Пара вершины v в паросочетании, -1 если свободна.
+        size_t mate(size_t v) const { return _mate[v]; }
+
+        // Рёбра паросочетания {левая, правая}.
+        vector<GraphEdge> matching() const {
+            vector<GraphEdge> m;
+            m.reserve(_size);
+            for (size_t v = 0; v < _mate.size(); v++) {
+                if (_left[v] && _mate[v] != NONE) m.push_back({v, _mate[v]});
+            }
+            return m;
+        }
+
+        // Минимальное вершинное покрытие. Теорема Кёнига:
+        // Z - вершины, достижимые из свободных вершин левой доли по чередующимся путям. Покрытие (L \ Z) + (R & Z).
+        vector<size_t> minVertexCover() const {
+            vector<bool> z(_mate.size());
+            queue<size_t> q;
+            for (size_t u = 0; u < _mate.size(); u++) {
+                if (_left[u] && _mate[u] == NONE) {
+                    z[u] = true;
+                    q.push(u);
+                }
+            }
+            while (!q.empty()) {
+                size_t u = q.front(); q.pop();
+                for (size_t w : _adj.adjacent(u)) {
+                    if (_left[w] || z[w] || _mate[u] == w) continue;
+                    z[w] = true;
+                    size_t m = _mate[w];
+                    if (m != NONE && !z[m]) {
+                        z[m] = true;
+                        q.push(m);
+                    }
+                }
+            }
+            vector<size_t> cover;
+            cover.reserve(_size);
+            for (size_t v = 0; v < _mate.size(); v++) {
+                if (_left[v] != z[v]) cover.push_back(v);
+            }
+            return cover;
+        }
+    };
+
+    // Ускоритель вызова. Доли определяются раскраской BI_T.
+    template <class G>
+    HopcroftKarp_T<G> hopcroftKarp(const G& g, bool greedy = true) {
+        auto bi = BI(g);
+        traverse(g, bi);
+        assert(bi.bipartite());
+        return HopcroftKarp_T<G>(g, bi, greedy);
+    }
+}
+
+void matchingTest();
+
+#endif /* matching_h */
@@ -0,0 +1,100 @@
+//
+//  matchingTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сверка паросочетания Хопкрофта-Карпа с алгоритмом Куна на случайных двудольных графах.
+
+#include <iostream>
+#include <random>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "matching.h"
+
+using namespace std;
+using namespace Graph;
+
+// Алгоритм Куна: поиск увеличивающего пути в глубину из каждой вершины левой доли. O(VE).
+class Kuhn {
+    const SparseGraph& g;
+    vector<size_t> mate;
+    vector<char> used;
+
+    bool augment_(size_t v) {
+        if (used[v]) return false;
+        used[v] = true;
+        for (size_t w : g.adjacent(v)) {
+            if (mate[w] == -1 || augment_(mate[w])) {
+                mate[w] = v;
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    size_t size = 0;
+
+    Kuhn(const SparseGraph& g, const vector<bool>& left) : g(g), mate(g.size(), -1) {
+        for (size_t v = 0; v < g.size(); v++) {
+            if (!left[v]) continue;
+            used.assign(g.size(), false);
+            size += augment_(v);
+        }
+    }
+};
+
+// Паросочетание максимально, состоит из рёбер графа без общих вершин и согласовано с mate().
+// Покрытие имеет размер паросочетания и содержит конец каждого ребра.
+static bool valid(const HopcroftKarp_T<SparseGraph>& hk, const SparseGraph& g, size_t expected) {
+    const size_t n = g.size();
+    if (hk.size() != expected) return false;
+    auto m = hk.matching();
+    if (m.size() != expected) return false;
+    vector<char> used(n);
+    for (auto& e : m) {
+        if (!g.edge(e.v, e.w) || used[e.v] || used[e.w]) return false;
+        if (hk.mate(e.v) != e.w || hk.mate(e.w) != e.v) return false;
+        used[e.v] = used[e.w] = true;
+    }
+    for (size_t v = 0; v < n; v++) {
+        if (!used[v] && hk.mate(v) != -1) return false;
+    }
+    auto cover = hk.minVertexCover();
+    if (cover.size() != expected) return false;
+    vector<char> covered(n);
+    for (size_t v : cover) covered[v] = true;
+    for (size_t v = 0; v < n; v++) {
+        for (size_t w : g.adjacent(v)) {
+            if (!covered[v] && !covered[w]) return false;
+        }
+    }
+    return true;
+}
+
+void matchingTest()
+{
+    mt19937 rnd(31);
+    bool greedy = true, plain = true, coloring = true;
+    for (int i = 0; i < 500; i++) {
+        const size_t n = 1 + rnd() % 80, m = rnd() % (3 * n + 1);
+        vector<bool> left(n);
+        for (size_t v = 0; v < n; v++) left[v] = rnd() % 2;
+        SparseGraph g(n);
+        for (size_t k = 0; k < m; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            if (left[v] != left[w]) g.insert({v, w});
+        }
+        const size_t expected = Kuhn(g, left).size;
+        greedy &= valid(HopcroftKarp_T<SparseGraph>(g, left, true), g, expected);
+        plain &= valid(HopcroftKarp_T<SparseGraph>(g, left, false), g, expected);
+        // Доли по раскраске могут отличаться от left, размер паросочетания - нет.
+        coloring &= valid(hopcroftKarp(g), g, expected);
+    }
+    report("HopcroftKarp_T greedy", greedy);
+    report("HopcroftKarp_T", plain);
+    report("HopcroftKarp_T BI_T", coloring);
+}
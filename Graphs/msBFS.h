@@ -0,0 +1,123 @@
+//
+//  msBFS.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Multi-Source BFS - одновременный обход в ширину из пачки источников.
+
+#ifndef msBFS_h
+#define msBFS_h
+
+#include <vector>
+#include <cstdint>
+#include "graphBase.h"
+#include "debug.h"
+
+namespace Graph {
+
+    // Битовая маска источников пачки. Бит i относится к i-му источнику пачки.
+    template <size_t Words> struct LaneMask {
+        uint64_t w[Words] = {};
+
+        bool any() const {
+            for (size_t i = 0; i < Words; i++) if (w[i]) return true;
+            return false;
+        }
+        void reset() { for (size_t i = 0; i < Words; i++) w[i] = 0; }
+        void set(size_t i) { w[i / 64] |= uint64_t(1) << (i % 64); }
+        LaneMask& operator|=(const LaneMask& m) { for (size_t i = 0; i < Words; i++) w[i] |= m.w[i]; return *this; }
+
+        // Вызывает f(i) для каждого установленного бита i.
+        template <class F> void forEach(F&& f) const {
+            for (size_t i = 0; i < Words; i++) {
+                for (uint64_t x = w[i]; x != 0; x &= x - 1) {
+                    f(i * 64 + __builtin_ctzll(x));
+                }
+            }
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // MS-BFS. Then et al. "The More the Merrier: Efficient Multi-Source Graph Traversal". 2014.
+    // Lanes обходов в ширину (64, 128, 256...) выполняются одновременно: у каждой вершины три битовых слова
+    // seen (каким обходам вершина уже известна), visit (какие обходы находятся в вершине на текущем уровне)
+    // и visitNext (какие обходы придут в вершину на следующем уровне).
+    // Все обходы, находящиеся в вершине v, разделяют один просмотр её списка смежности.
+    // O(D(V + E) * Lanes/64) на пачку, D - наибольшая глубина обхода в пачке.
+    template <class G, size_t Lanes = 64> class MSBFS_T {
+        static_assert(Lanes > 0 && Lanes % 64 == 0, "Lanes must be a multiple of 64");
+        using Mask = LaneMask<Lanes / 64>;
+
+        const G& _g;
+        std::vector<Mask> _seen, _visit, _visitNext;
+
+        // Обход из источников sources[first, last). last - first <= Lanes.
+        template <class Visitor> void batch_(const std::vector<size_t>& sources, size_t first, size_t last, Visitor& visitor) {
+            for (auto& m : _seen) m.reset();
+            for (auto& m : _visit) m.reset();
+
+            for (size_t i = first; i < last; i++) {
+                size_t v = sources[i];
+                _seen[v].set(i - first);
+                _visit[v].set(i - first);
+                visitor(i, v, 0);
+            }
+
+            bool more = true;
+            for (size_t depth = 1; more; depth++) {
+                more = false;
+                // Проталкиваем обходы текущего уровня в смежные вершины.
+                for (size_t v = 0; v < _g.size(); v++) {
+                    const Mask& visit = _visit[v];
+                    if (!visit.any()) continue;
+                    for (size_t w : _g.adjacent(v)) {
+                        _visitNext[w] |= visit;
+                    }
+                }
+                // Оставляем только обходы, впервые пришедшие в вершину.
+                for (size_t v = 0; v < _g.size(); v++) {
+                    Mask& next = _visitNext[v];
+                    Mask& visit = _visit[v];
+                    Mask& seen = _seen[v];
+                    bool found = false;
+                    for (size_t i = 0; i < Lanes / 64; i++) {
+                        visit.w[i] = next.w[i] & ~seen.w[i];
+                        seen.w[i] |= visit.w[i];
+                        found |= visit.w[i] != 0;
+                    }
+                    next.reset();
+                    if (found) {
+                        more = true;
+                        visit.forEach([&](size_t i) { visitor(first + i, v, depth); });
+                    }
+                }
+            }
+        }
+
+    public:
+        MSBFS_T(const G& g) : _g(g), _seen(g.size()), _visit(g.size()), _visitNext(g.size()) { trace("MSBFS_T"); }
+
+        // Обход из всех источников пачками по Lanes.
+        // visitor(i, v, d) вызывается один раз для каждой вершины v, достижимой из sources[i], d - длина кратчайшего пути.
+        template <class Visitor> void solve(const std::vector<size_t>& sources, Visitor&& visitor) {
+            for (size_t first = 0; first < sources.size(); first += Lanes) {
+                batch_(sources, first, std::min(sources.size(), first + Lanes), visitor);
+            }
+        }
+
+        // Таблица расстояний. Строка i - расстояния из sources[i] до всех вершин, -1 для недостижимых.
+        std::vector<std::vector<size_t>> distances(const std::vector<size_t>& sources) {
+            std::vector<std::vector<size_t>> d(sources.size(), std::vector<size_t>(_g.size(), -1));
+            solve(sources, [&d](size_t i, size_t v, size_t depth) { d[i][v] = depth; });
+            return d;
+        }
+    };
+
+    // Ускоритель вызова.
+    template <size_t Lanes = 64, class G>
+    MSBFS_T<G, Lanes> msBFS(const G& g) { return MSBFS_T<G, Lanes>(g); }
+}
+
+#endif /* msBFS_h */
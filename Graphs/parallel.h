@@ -0,0 +1,76 @@
+//
+//  parallel.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Примитивы распараллеливания алгоритмов на std::thread.
+
+#ifndef parallel_h
+#define parallel_h
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+namespace Graph {
+
+    // Заданное количество потоков. 0 - по количеству ядер.
+    inline std::atomic<size_t>& threadsLimit_() {
+        static std::atomic<size_t> limit(0);
+        return limit;
+    }
+
+    // Ограничение количества потоков параллельных алгоритмов. 0 - по количеству ядер.
+    inline void setThreadsCount(size_t n) { threadsLimit_() = n; }
+
+    // Количество потоков для параллельных алгоритмов.
+    inline size_t threadsCount() {
+        size_t n = threadsLimit_();
+        if (n == 0) n = std::thread::hardware_concurrency();
+        return n != 0 ? n : 1;
+    }
+
+    template <class G> auto prepareGraph_(const G& g, int) -> decltype(g.prepare(), void()) { g.prepare(); }
+    template <class G> void prepareGraph_(const G&, long) {}
+
+    // Подготовка графа к чтению из нескольких потоков. Графы с ленивой подготовкой (SparseGraph_T::prepare())
+    // готовятся сразу, остальные не меняются.
+    template <class G> void prepareForParallel(const G& g) { prepareGraph_(g, 0); }
+
+    // Параллельный цикл: f(i, t) для всех i из [first, last), t - номер потока в [0, threadsCount()).
+    // Диапазон делится на порции по grain, которые потоки разбирают динамически.
+    template <class F> void parallelForT(size_t first, size_t last, F&& f, size_t grain = 1024) {
+        if (last <= first) return;
+        size_t threads = std::min(threadsCount(), (last - first + grain - 1) / grain);
+        if (threads <= 1) {
+            for (size_t i = first; i < last; i++) f(i, size_t(0));
+            return;
+        }
+
+        std::atomic<size_t> next(first);
+        auto worker = [&](size_t t) {
+            for (;;) {
+                size_t b = next.fetch_add(grain);
+                if (b >= last) break;
+                size_t e = std::min(last, b + grain);
+                for (size_t i = b; i < e; i++) f(i, t);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (size_t t = 1; t < threads; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+    }
+
+    // Параллельный цикл: f(i) для всех i из [first, last).
+    template <class F> void parallelFor(size_t first, size_t last, F&& f, size_t grain = 1024) {
+        parallelForT(first, last, [&f](size_t i, size_t) { f(i); }, grain);
+    }
+}
+
+#endif /* parallel_h */
@@ -0,0 +1,114 @@
+//
+//  parallelCC.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Параллельное вычисление компонент связности неориентированного графа.
+
+#ifndef parallelCC_h
+#define parallelCC_h
+
+#include <vector>
+#include <random>
+#include <unordered_map>
+#include "graphBase.h"
+#include "searchGraph.h"
+#include "disjointSet.h"
+#include "parallel.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Компоненты связности. Алгоритм Afforest. Sutton, Ben-Nun, Barak 2018.
+    // Заменяет CC_T для неориентированных графов, интерфейс size(), id(v), connected(v, w) тот же,
+    // нумерация компонент совпадает с CC_T - в порядке наименьших вершин.
+    // 1. Каждая вершина параллельно объединяется с первыми neighborRounds соседями (neighbor sampling).
+    //    После этого почти все вершины оказываются в одной гигантской компоненте.
+    // 2. Гигантская компонента определяется по случайной выборке вершин.
+    // 3. Для вершин вне гигантской компоненты объединяем оставшихся соседей.
+    //    Вершины гигантской компоненты пропускаем: их ребра наружу будут обработаны с другого конца.
+    // O(V + E) работы, E' << E ребер просматривается на практике.
+    template <class G> class CCAfforest_T {
+        static_assert(!G::Traits::directed, "CCAfforest_T requires undirected graph");
+
+        size_t cnt; // количество вершин.
+        size_t scnt; // количество компонент.
+        vector<size_t> ids;
+
+        friend void SCTrace<CCAfforest_T>(ostream&, const CCAfforest_T&);
+
+        // Наиболее частый представитель в случайной выборке вершин.
+        static size_t sampleFrequent_(const ConcurrentDisjointSet& ds) {
+            const size_t samples = 1024;
+            std::mt19937_64 gen(ds.size());
+            std::uniform_int_distribution<size_t> dis(0, ds.size() - 1);
+            std::unordered_map<size_t, size_t> freq;
+            size_t best = 0, bestCount = 0;
+            for (size_t i = 0; i < samples; i++) {
+                size_t r = ds.find(dis(gen));
+                if (++freq[r] > bestCount) {
+                    bestCount = freq[r];
+                    best = r;
+                }
+            }
+            return best;
+        }
+
+    public:
+        CCAfforest_T(const G& g, size_t neighborRounds = 2) : cnt(g.size()), scnt(0), ids(g.size()) {
+            trace("CCAfforest_T");
+            if (g.size() == 0) return;
+            prepareForParallel(g);
+
+            ConcurrentDisjointSet ds(g.size());
+
+            // 1. Neighbor sampling.
+            for (size_t r = 0; r < neighborRounds; r++) {
+                parallelFor(0, g.size(), [&](size_t v) {
+                    size_t i = 0;
+                    for (size_t w : g.adjacent(v)) {
+                        if (i++ == r) {
+                            ds.uniteIfNotConnected(v, w);
+                            break;
+                        }
+                    }
+                });
+                parallelFor(0, g.size(), [&](size_t v) { ds.find(v); });
+            }
+
+            // 2. Гигантская компонента.
+            const size_t frequent = sampleFrequent_(ds);
+
+            // 3. Оставшиеся ребра вершин вне гигантской компоненты.
+            parallelFor(0, g.size(), [&](size_t v) {
+                if (ds.find(v) == frequent) return;
+                size_t i = 0;
+                for (size_t w : g.adjacent(v)) {
+                    if (i++ < neighborRounds) continue;
+                    ds.uniteIfNotConnected(v, w);
+                }
+            }, 256);
+
+            parallelFor(0, g.size(), [&](size_t v) { ids[v] = ds.find(v); });
+
+            // Представитель - наименьшая вершина компоненты, поэтому к моменту обработки v её представитель уже перенумерован.
+            for (size_t v = 0; v < g.size(); v++) {
+                size_t r = ids[v];
+                ids[v] = r == v ? scnt++ : ids[r];
+            }
+        }
+
+        size_t size() const { return scnt; }
+        size_t id(size_t v) const { return ids[v]; }
+        bool connected(size_t v, size_t w) const { return ids[v] == ids[w]; }
+    };
+
+    // Ускоритель вызова.
+    template <class G>
+    CCAfforest_T<G> CCAfforest(const G& g) { return CCAfforest_T<G>(g); }
+}
+
+#endif /* parallelCC_h */
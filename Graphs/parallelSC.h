@@ -0,0 +1,289 @@
+//
+//  parallelSC.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Параллельное вычисление сильных компонент орграфа.
+
+#ifndef parallelSC_h
+#define parallelSC_h
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "graphBase.h"
+#include "searchGraph.h"
+#include "csrGraph.h"
+#include "parallel.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Сильные компоненты. Алгоритм FW-BW-Trim. Fleischer, Hendrickson, Pinar 2000; McLendon et al. 2005.
+    // Заменяет SCTar_T и SCGab_T, интерфейс size(), id(v), connected(v, w) тот же, номера компонент так же
+    // в обратном топологическом порядке, поэтому SCPar_T годится для Condensation_T и TCSC_T.
+    // Задача - подмножество вершин S, вершины задачи помечены её цветом.
+    // 1. Trim: вершины без входящих или исходящих рёбер внутри S - одиночные компоненты. Удаление открывает новые,
+    //    поэтому отсечение идёт волнами с атомарными счётчиками степеней до исчерпания.
+    // 2. FW-BW: из опорной вершины p параллельными BFS находятся достижимые F и достигающие p вершины B.
+    //    F ∩ B - компонента p. F \ B, B \ F и остаток S \ (F ∪ B) не связаны общими компонентами - это новые задачи.
+    // 3. Задачи не больше tarjanLimit вершин решаются последовательным итеративным Тарьяном.
+    // Для графов с гигантской компонентой и множеством одиночных вершин (веб-граф) почти вся работа - одна волна
+    // отсечения и два BFS, т.е. O(V + E) с параллелизмом внутри каждого шага.
+    // Память - прямой и транспонированный CSR: 2 * (V * 8 + E * 4) байт.
+    template <class G> class SCPar_T {
+        static_assert(G::Traits::directed, "SCPar_T requires directed graph");
+
+        using Index = uint32_t;
+        using Adj = CSRGraph_T<DirectedGraphTraits, Index>;
+
+        size_t cnt; // количество вершин.
+        size_t scnt; // количество сильных компонент.
+        vector<size_t> ids;
+
+        friend void SCTrace<SCPar_T>(ostream&, const SCPar_T&);
+
+        // Рабочие буферы алгоритма, освобождаются после построения.
+        class Solver {
+            static constexpr Index DONE = Index(-1); // Цвет вершин с назначенной компонентой.
+            static constexpr Index NONE = Index(-1); // Вершина не посещена Тарьяном.
+            static constexpr uint8_t FW = 1, BW = 2;
+
+            // Порядок выдачи компонент задаётся стеком: задача, выложенная позже, выдаёт номера раньше.
+            enum Kind { SOLVE, COMPONENT, SINGLETONS };
+            struct Task {
+                Kind kind;
+                Index color;
+                vector<Index> vs;
+            };
+
+            SCPar_T& _sc;
+            const Adj _g; // Прямой граф.
+            const Adj _r; // Транспонированный граф.
+            const size_t _tarjanLimit;
+            vector<Index> _color; // Цвет задачи вершины. Во время параллельных шагов только читается.
+            vector<atomic<uint8_t>> _mark; // FW | BW.
+            vector<atomic<Index>> _in, _out; // Степени внутри задачи.
+            vector<Index> _enter, _low; // Тарьян.
+            Index _enterCnt = 0;
+            Index _colorCnt = 0;
+            vector<Task> _tasks;
+
+            void emit_(Index v) {
+                _sc.ids[v] = _sc.scnt++;
+                _color[v] = DONE;
+            }
+
+            // Отсечение тривиальных компонент задачи. Стоки получают номера сразу: их потомки в S уже отсечены.
+            // Истоки возвращаются по волнам в обратном порядке: их номера после всех остальных вершин задачи.
+            vector<Index> trim_(vector<Index>& vs, Index c) {
+                const size_t threads = threadsCount();
+                vector<vector<Index>> nextSinks(threads), nextSources(threads);
+                parallelForT(0, vs.size(), [&](size_t i, size_t t) {
+                    Index v = vs[i], in = 0, out = 0;
+                    for (size_t w : _g.adjacent(v)) out += w != v && _color[w] == c;
+                    for (size_t w : _r.adjacent(v)) in += w != v && _color[w] == c;
+                    _out[v].store(out, memory_order_relaxed);
+                    _in[v].store(in, memory_order_relaxed);
+                    if (out == 0) nextSinks[t].push_back(v);
+                    else if (in == 0) nextSources[t].push_back(v);
+                }, 256);
+
+                vector<vector<Index>> sourceWaves;
+                vector<Index> sinks, sources;
+                for (;;) {
+                    // Захват волны последовательно: вершина могла попасть в обе очереди.
+                    sinks.clear();
+                    sources.clear();
+                    for (auto& l : nextSinks) {
+                        for (Index v : l) if (_color[v] == c) { emit_(v); sinks.push_back(v); }
+                        l.clear();
+                    }
+                    for (auto& l : nextSources) {
+                        for (Index v : l) if (_color[v] == c) { _color[v] = DONE; sources.push_back(v); }
+                        l.clear();
+                    }
+                    if (sinks.empty() && sources.empty()) break;
+                    // Удаление стока уменьшает исходящие степени предков, истока - входящие степени потомков.
+                    parallelForT(0, sinks.size() + sources.size(), [&](size_t i, size_t t) {
+                        if (i < sinks.size()) {
+                            for (size_t u : _r.adjacent(sinks[i])) {
+                                if (_color[u] == c && _out[u].fetch_sub(1, memory_order_relaxed) == 1) nextSinks[t].push_back(Index(u));
+                            }
+                        } else {
+                            for (size_t w : _g.adjacent(sources[i - sinks.size()])) {
+                                if (_color[w] == c && _in[w].fetch_sub(1, memory_order_relaxed) == 1) nextSources[t].push_back(Index(w));
+                            }
+                        }
+                    }, 256);
+                    if (!sources.empty()) sourceWaves.push_back(sources);
+                }
+
+                vector<Index> result;
+                for (size_t i = sourceWaves.size(); i-- > 0; ) result.insert(result.end(), sourceWaves[i].begin(), sourceWaves[i].end());
+                size_t k = 0;
+                for (Index v : vs) if (_color[v] == c) vs[k++] = v;
+                vs.resize(k);
+                return result;
+            }
+
+            // Опорная вершина - с наибольшим произведением степеней: вероятнее всего лежит в гигантской компоненте.
+            Index pivot_(const vector<Index>& vs) {
+                vector<pair<uint64_t, Index>> best(threadsCount(), {0, vs[0]});
+                parallelForT(0, vs.size(), [&](size_t i, size_t t) {
+                    Index v = vs[i];
+                    uint64_t d = uint64_t(_in[v].load(memory_order_relaxed) + 1) * (_out[v].load(memory_order_relaxed) + 1);
+                    if (d > best[t].first) best[t] = {d, v};
+                });
+                auto b = best[0];
+                for (auto& x : best) if (x.first > b.first) b = x;
+                return b.second;
+            }
+
+            // Параллельный BFS по уровням из p по вершинам цвета c. Посещённые помечаются битом bit.
+            void reach_(const Adj& a, Index p, Index c, uint8_t bit) {
+                vector<vector<Index>> next(threadsCount());
+                vector<Index> frontier(1, p);
+                _mark[p].fetch_or(bit, memory_order_relaxed);
+                while (!frontier.empty()) {
+                    parallelForT(0, frontier.size(), [&](size_t i, size_t t) {
+                        for (size_t w : a.adjacent(frontier[i])) {
+                            if (_color[w] != c || (_mark[w].load(memory_order_relaxed) & bit)) continue;
+                            if (!(_mark[w].fetch_or(bit, memory_order_relaxed) & bit)) next[t].push_back(Index(w));
+                        }
+                    }, 256);
+                    frontier.clear();
+                    for (auto& l : next) {
+                        frontier.insert(frontier.end(), l.begin(), l.end());
+                        l.clear();
+                    }
+                }
+            }
+
+            // Итеративный алгоритм Тарьяна на вершинах цвета c. Компоненты выдаются в обратном топологическом порядке.
+            void tarjan_(const vector<Index>& vs, Index c) {
+                struct Frame {
+                    Index v;
+                    size_t next; // Следующее ребро.
+                };
+                vector<Frame> path;
+                vector<Index> st;
+                for (Index s : vs) {
+                    if (_color[s] != c || _enter[s] != NONE) continue;
+                    _enter[s] = _low[s] = _enterCnt++;
+                    st.push_back(s);
+                    path.push_back({s, 0});
+                    while (!path.empty()) {
+                        Frame& f = path.back();
+                        auto adj = _g.adjacent(f.v);
+                        if (f.next < adj.size()) {
+                            size_t w = adj[f.next++];
+                            // Вершины с назначенной компонентой и вне задачи пропускаются, прочие посещённые - в стеке.
+                            if (_color[w] != c) continue;
+                            if (_enter[w] == NONE) {
+                                _enter[w] = _low[w] = _enterCnt++;
+                                st.push_back(Index(w));
+                                path.push_back({Index(w), 0});
+                            } else if (_enter[w] < _low[f.v]) {
+                                _low[f.v] = _enter[w];
+                            }
+                            continue;
+                        }
+                        Index v = f.v;
+                        path.pop_back();
+                        if (_low[v] == _enter[v]) {
+                            Index w;
+                            do {
+                                w = st.back(); st.pop_back();
+                                _sc.ids[w] = _sc.scnt;
+                                _color[w] = DONE;
+                            } while (w != v);
+                            _sc.scnt++;
+                        }
+                        if (!path.empty() && _low[v] < _low[path.back().v]) _low[path.back().v] = _low[v];
+                    }
+                }
+            }
+
+            Index newColor_(vector<Index>& vs) {
+                Index c = ++_colorCnt;
+                for (Index v : vs) _color[v] = c;
+                return c;
+            }
+
+            void solve_(vector<Index>& vs, Index c) {
+                vector<Index> sources = trim_(vs, c);
+                if (!sources.empty()) _tasks.push_back({SINGLETONS, DONE, std::move(sources)});
+                if (vs.size() <= _tarjanLimit) {
+                    tarjan_(vs, c);
+                    return;
+                }
+                const Index p = pivot_(vs);
+                reach_(_g, p, c, FW);
+                reach_(_r, p, c, BW);
+                vector<Index> scc, f, b, rest;
+                for (Index v : vs) {
+                    switch (_mark[v].exchange(0, memory_order_relaxed)) {
+                        case FW | BW: scc.push_back(v); break;
+                        case FW: f.push_back(v); break;
+                        case BW: b.push_back(v); break;
+                        default: rest.push_back(v);
+                    }
+                }
+                // Рёбра идут только B \ F -> F ∩ B -> F \ B, B \ F -> остаток -> F \ B.
+                // Обратный топологический порядок выдачи: F \ B, F ∩ B, остаток, B \ F.
+                if (!b.empty()) _tasks.push_back({SOLVE, newColor_(b), std::move(b)});
+                if (!rest.empty()) _tasks.push_back({SOLVE, newColor_(rest), std::move(rest)});
+                for (Index v : scc) _color[v] = DONE;
+                _tasks.push_back({COMPONENT, DONE, std::move(scc)});
+                if (!f.empty()) _tasks.push_back({SOLVE, newColor_(f), std::move(f)});
+            }
+
+        public:
+            Solver(SCPar_T& sc, const G& g, size_t tarjanLimit) : _sc(sc), _g(g), _r(g, true), _tarjanLimit(tarjanLimit),
+                _color(g.size(), 0), _mark(g.size()), _in(g.size()), _out(g.size()), _enter(g.size(), NONE), _low(g.size()) {}
+
+            void run() {
+                vector<Index> all(_g.size());
+                for (size_t v = 0; v < all.size(); v++) all[v] = Index(v);
+                _tasks.push_back({SOLVE, 0, std::move(all)});
+                while (!_tasks.empty()) {
+                    Task task = std::move(_tasks.back());
+                    _tasks.pop_back();
+                    switch (task.kind) {
+                        case SOLVE:
+                            solve_(task.vs, task.color);
+                            break;
+                        case COMPONENT:
+                            for (Index v : task.vs) _sc.ids[v] = _sc.scnt;
+                            _sc.scnt++;
+                            break;
+                        case SINGLETONS:
+                            for (Index v : task.vs) _sc.ids[v] = _sc.scnt++;
+                            break;
+                    }
+                }
+            }
+        };
+
+    public:
+        // tarjanLimit - размер задачи, начиная с которого последовательный Тарьян выгоднее параллельных шагов.
+        SCPar_T(const G& g, size_t tarjanLimit = 4096) : cnt(g.size()), scnt(0), ids(g.size()) {
+            trace("SCPar_T");
+            assert(g.size() < Index(-1));
+            Solver(*this, g, tarjanLimit).run();
+        }
+
+        size_t size() const { return scnt; }
+        size_t id(size_t v) const { return ids[v]; }
+        bool connected(size_t v, size_t w) const { return ids[v] == ids[w]; }
+    };
+
+    // Ускоритель вызова.
+    template <class G> SCPar_T<G> SCPar(const G& g) { return SCPar_T<G>(g); }
+}
+
+#endif /* parallelSC_h */
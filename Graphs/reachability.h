@@ -0,0 +1,197 @@
+//
+//  reachability.h
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Индексы достижимости размера ~O(V + E) вместо транзитивного замыкания O(V^2).
+
+#ifndef reachability_h
+#define reachability_h
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include "graphBase.h"
+#include "csrGraph.h"
+#include "strongComponents.h"
+#include "debug.h"
+
+namespace Graph {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // GRAIL - индекс достижимости в DAG на случайных интервальных метках. Yildirim, Chaoji, Zaki 2010.
+    // k раз выполняется DFS со случайным порядком корней и потомков. Метка вершины в обходе i -
+    // интервал [low, post]: post - номер в обратном порядке обхода, low - наименьший post среди потомков.
+    // Если w достижима из v, интервал w вложен в интервал v во всех k обходах. Обратное неверно: вложенность во всех
+    // обходах только допускает достижимость, тогда она проверяется DFS из v, отсекающим вершины, в интервалы которых
+    // w не вложена.
+    // Индекс O(kV), построение O(k(V + E)). Запрос O(k) для большинства недостижимых пар, иначе O(k(V + E)) в худшем случае.
+    // Запросы используют общий буфер посещённых вершин, поэтому не потокобезопасны.
+    template <class G> class Grail_T {
+    public:
+        using Adj = CSRGraph_T<DAGTraits, uint32_t>;
+
+    private:
+        struct Interval {
+            uint32_t low, post;
+        };
+
+        shared_ptr<const Adj> _dag;
+        const Adj& _g;
+        size_t _k; // Количество обходов.
+        vector<Interval> _labels; // Метки вершины v: [v * k, (v + 1) * k).
+        mutable vector<uint32_t> _seen; // Эпоха посещения вершины в запросе.
+        mutable uint32_t _epoch = 0;
+        mutable vector<uint32_t> _stack;
+        double _buildTime = 0;
+
+        // Интервал w вложен в интервал v во всех обходах.
+        bool contains_(size_t v, size_t w) const {
+            const Interval* a = &_labels[v * _k];
+            const Interval* b = &_labels[w * _k];
+            for (size_t i = 0; i < _k; i++) {
+                if (b[i].low < a[i].low || b[i].post > a[i].post) return false;
+            }
+            return true;
+        }
+
+        // Следующая эпоха. При переполнении буфер очищается.
+        uint32_t nextEpoch_() const {
+            if (++_epoch == 0) {
+                fill(_seen.begin(), _seen.end(), 0);
+                _epoch = 1;
+            }
+            return _epoch;
+        }
+
+        // Обход i. Случайный порядок потомков - обход списка смежности со случайного смещения.
+        void label_(size_t i, mt19937& gen) {
+            struct Frame {
+                uint32_t v, next, start, low;
+            };
+            const size_t n = _g.size();
+            vector<uint32_t> roots(n);
+            for (size_t v = 0; v < n; v++) roots[v] = uint32_t(v);
+            shuffle(roots.begin(), roots.end(), gen);
+
+            const uint32_t epoch = nextEpoch_();
+            vector<Frame> st;
+            uint32_t post = 0;
+            auto push = [&](uint32_t v) {
+                _seen[v] = epoch;
+                size_t deg = _g.adjacent(v).size();
+                st.push_back({v, 0, deg ? uint32_t(gen() % deg) : 0, uint32_t(-1)});
+            };
+            for (uint32_t r : roots) {
+                if (_seen[r] == epoch) continue;
+                push(r);
+                while (!st.empty()) {
+                    Frame& f = st.back();
+                    auto adj = _g.adjacent(f.v);
+                    if (f.next < adj.size()) {
+                        size_t c = adj[(f.start + f.next++) % adj.size()];
+                        // В DAG посещённый потомок уже завершён и его метка готова.
+                        if (_seen[c] == epoch) f.low = min(f.low, _labels[c * _k + i].low);
+                        else push(uint32_t(c));
+                    } else {
+                        Interval& l = _labels[f.v * _k + i];
+                        l.post = post++;
+                        l.low = min(f.low, l.post);
+                        st.pop_back();
+                        if (!st.empty()) st.back().low = min(st.back().low, l.low);
+                    }
+                }
+            }
+        }
+
+        void build_(size_t seed) {
+            assert(_g.size() < uint32_t(-1));
+            auto start = chrono::steady_clock::now();
+            mt19937 gen{uint32_t(seed)};
+            for (size_t i = 0; i < _k; i++) label_(i, gen);
+            _buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+
+    public:
+        // g - DAG. k - количество обходов: больше k - реже DFS в запросах, но больше индекс.
+        Grail_T(const G& g, size_t k = 3, size_t seed = 1) : Grail_T(make_shared<const Adj>(g), k, seed) {}
+
+        // DAG в виде готового CSR без копирования, например конденсация Condensation_T.
+        Grail_T(shared_ptr<const Adj> dag, size_t k = 3, size_t seed = 1) : _dag(std::move(dag)), _g(*_dag), _k(k),
+            _labels(_g.size() * k), _seen(_g.size())
+        {
+            trace("Grail_T");
+            build_(seed);
+        }
+
+        size_t size() const { return _g.size(); }
+
+        bool reachable(size_t v, size_t w) const {
+            if (v == w) return true;
+            if (!contains_(v, w)) return false;
+            const uint32_t epoch = nextEpoch_();
+            _stack.assign(1, uint32_t(v));
+            _seen[v] = epoch;
+            while (!_stack.empty()) {
+                size_t u = _stack.back(); _stack.pop_back();
+                for (size_t c : _g.adjacent(u)) {
+                    if (c == w) return true;
+                    if (_seen[c] != epoch && contains_(c, w)) {
+                        _seen[c] = epoch;
+                        _stack.push_back(uint32_t(c));
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Время построения индекса в секундах.
+        double buildTime() const { return _buildTime; }
+
+        // Занимаемая память в байтах.
+        size_t memory() const {
+            return _g.memory() + _labels.capacity() * sizeof(Interval) + _seen.capacity() * sizeof(uint32_t);
+        }
+    };
+
+    // Ускоритель вызова.
+    template <class G> Grail_T<G> grail(const G& g, size_t k = 3) { return Grail_T<G>(g, k); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // GRAIL для произвольного орграфа: сильные компоненты сжимаются в вершины базового DAG - конденсацию
+    // Condensation_T. Интерфейс reachable(v, w) как у TCSC_T.
+    template <class G> class GrailSC_T {
+        using Cond = Condensation_T<G>;
+
+        Cond _cond;
+        Grail_T<typename Cond::DAG> _grail;
+
+    public:
+        GrailSC_T(const G& g, size_t k = 3) : _cond(g), _grail(_cond.sharedDag(), k) { trace("GrailSC_T"); }
+
+        bool reachable(size_t v, size_t w) const {
+            return _cond.connected(v, w) || _grail.reachable(_cond.id(v), _cond.id(w));
+        }
+
+        // Время построения индекса конденсации в секундах.
+        double buildTime() const { return _grail.buildTime(); }
+
+        // Занимаемая память индекса в байтах.
+        size_t memory() const { return _grail.memory(); }
+
+        // Количество сильных компонент - вершин конденсации.
+        size_t components() const { return _cond.size(); }
+    };
+
+    // Ускоритель вызова.
+    template <class G> GrailSC_T<G> grailSC(const G& g, size_t k = 3) { return GrailSC_T<G>(g, k); }
+}
+
+void reachabilityTest();
+
+#endif /* reachability_h */
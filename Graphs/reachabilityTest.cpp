@@ -0,0 +1,101 @@
+//
+//  reachabilityTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сверка индексов достижимости и сжатых строк замыкания с замыканием, построенным обходом из каждой вершины.
+
+#include <iostream>
+#include <random>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "parallel.h"
+#include "reachability.h"
+#include "dag.h"
+#include "parallelSC.h"
+#include "compressedBitmap.h"
+
+using namespace std;
+using namespace Graph;
+
+// Транзитивное замыкание перебором: обход в глубину из каждой вершины. O(V(V + E)).
+template <class G> static vector<vector<bool>> bruteClosure(const G& g) {
+    const size_t n = g.size();
+    vector<vector<bool>> tc(n, vector<bool>(n));
+    vector<size_t> stack;
+    for (size_t s = 0; s < n; s++) {
+        tc[s][s] = true;
+        stack.assign(1, s);
+        while (!stack.empty()) {
+            size_t v = stack.back(); stack.pop_back();
+            for (size_t w : g.adjacent(v)) {
+                if (!tc[s][w]) {
+                    tc[s][w] = true;
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+    return tc;
+}
+
+template <class R> static bool same(const R& r, const vector<vector<bool>>& tc) {
+    for (size_t v = 0; v < tc.size(); v++)
+        for (size_t w = 0; w < tc.size(); w++)
+            if (r.reachable(v, w) != tc[v][w]) return false;
+    return true;
+}
+
+// Объединение случайных множеств RoaringBitmap с разреженными и плотными блоками сверяется с vector<bool>.
+static bool roaring(mt19937& rnd) {
+    for (int i = 0; i < 50; i++) {
+        const uint32_t range = i % 2 ? 300000 : 70000;
+        RoaringBitmap x, y;
+        vector<bool> ref(range);
+        const size_t count = rnd() % 20000;
+        for (size_t k = 0; k < count; k++) {
+            uint32_t v = rnd() % range;
+            if (rnd() % 2) x.add(v);
+            else y.add(v);
+            ref[v] = true;
+        }
+        x |= y;
+        size_t expected = 0, visited = 0;
+        for (uint32_t v = 0; v < range; v++) {
+            if (x.contains(v) != ref[v]) return false;
+            expected += ref[v];
+        }
+        bool ok = true;
+        x.forEach([&](uint32_t v) { visited++; ok &= v < range && ref[v]; });
+        if (!ok || x.count() != expected || visited != expected) return false;
+    }
+    return true;
+}
+
+void reachabilityTest()
+{
+    setThreadsCount(4);
+    mt19937 rnd(21);
+    bool dagOk = true, scOk = true, tcscOk = true;
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 1 + rnd() % 200, m = rnd() % (3 * n + 1);
+        // Случайный орграф и DAG из его рёбер от больших вершин к меньшим.
+        SparseGraphD g(n), dag(n);
+        for (size_t k = 0; k < m; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            g.insert({v, w});
+            if (v > w) dag.insert({v, w});
+        }
+        dagOk &= same(grail(dag, 1 + i % 4), bruteClosure(dag));
+        auto tc = bruteClosure(g);
+        scOk &= same(grailSC(g, 1 + i % 4), tc);
+        tcscOk &= same(TCSC(g), tc) && same(TCSC_T<SparseGraphD, SCPar_T<SparseGraphD>>(g), tc);
+    }
+    report("Grail_T", dagOk);
+    report("GrailSC_T", scOk);
+    report("TCSC_T", tcscOk);
+    report("RoaringBitmap", roaring(rnd));
+}
@@ -0,0 +1,134 @@
+//
+//  scTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сверка вариантов поиска сильных компонент с алгоритмом Тарьяна SCTar_T на случайных орграфах.
+
+#include <iostream>
+#include <random>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "parallel.h"
+#include "csrGraph.h"
+#include "strongComponents.h"
+#include "incrementalSC.h"
+#include "parallelSC.h"
+
+using namespace std;
+using namespace Graph;
+
+// Разбиение на компоненты совпадает с SCTar_T, а номера компонент - обратный топологический порядок:
+// ребро ведёт из компоненты с большим номером в компоненту с меньшим или внутрь компоненты.
+template <class SC, class G> static bool samePartition(const SC& sc, const G& g) {
+    SCTar_T<G> tar(g);
+    if (sc.size() != tar.size()) return false;
+    for (size_t v = 0; v < g.size(); v++) {
+        for (size_t w = 0; w < g.size(); w++) {
+            if (sc.connected(v, w) != tar.connected(v, w)) return false;
+        }
+        for (size_t w : g.adjacent(v)) {
+            if (sc.id(v) < sc.id(w)) return false;
+        }
+    }
+    return true;
+}
+
+// Номера компонент совпадают с номерами базового алгоритма.
+template <class SC, class Base> static bool sameIds(const SC& sc, const Base& base, size_t n) {
+    if (sc.size() != base.size()) return false;
+    for (size_t v = 0; v < n; v++) {
+        if (sc.id(v) != base.id(v)) return false;
+    }
+    return true;
+}
+
+static SparseGraphD randomDigraph(mt19937& rnd, size_t n, size_t m) {
+    SparseGraphD g(n);
+    for (size_t k = 0; k < m; k++) g.insert({rnd() % n, rnd() % n});
+    return g;
+}
+
+// Инкрементальные компоненты после каждой вставки: те же компоненты, что у SCTar_T на текущем графе,
+// true из insert() ровно при слиянии, и каждое ребро между компонентами согласовано с их порядком precedes().
+static bool incrementalSC(mt19937& rnd) {
+    for (int i = 0; i < 300; i++) {
+        const size_t n = 2 + rnd() % 60;
+        IncrementalSC isc(i % 2 ? n : 0); // Без заданного размера вершины добавляются вставкой.
+        SparseGraphD g(n);
+        for (size_t k = 0; k < 3 * n; k++) {
+            size_t v = rnd() % n, w = rnd() % n;
+            if (i % 3 == 0 && v > w && rnd() % 8) swap(v, w); // Вставки почти по порядку.
+            // Ещё не добавленные вершины - одиночные компоненты.
+            const size_t before = isc.count() + n - isc.size();
+            const bool merged = isc.insert(v, w);
+            g.insert({v, w});
+            SCTar_T<SparseGraphD> tar(g);
+            const size_t after = isc.count() + n - isc.size();
+            if (after != tar.size() || merged != (after < before)) return false;
+            for (size_t a = 0; a < isc.size(); a++) {
+                for (size_t b = 0; b < isc.size(); b++) {
+                    if (isc.connected(a, b) != tar.connected(a, b)) return false;
+                }
+                for (size_t b : g.adjacent(a)) {
+                    if (!isc.connected(a, b) && !isc.precedes(a, b)) return false;
+                }
+            }
+        }
+        IncrementalSC fromGraph(g);
+        if (fromGraph.count() != SCTar(g).size()) return false;
+    }
+    return true;
+}
+
+void scTest()
+{
+    setThreadsCount(4);
+    mt19937 rnd(29);
+    bool kosaraju = true, kosarajuCSR = true;
+    for (int i = 0; i < 200; i++) {
+        const size_t n = 1 + rnd() % 200;
+        SparseGraphD g = randomDigraph(rnd, n, rnd() % (2 * n + 1));
+        kosaraju &= samePartition(CC(g), g);
+        CSRGraphD csr(g);
+        kosarajuCSR &= samePartition(CC(csr), g);
+    }
+    // Длинный цикл: обход без рекурсии не переполняет стек.
+    const size_t n = 1000000;
+    SparseGraphD ring(n);
+    for (size_t v = 0; v < n; v++) ring.insert({v, (v + 1) % n});
+    kosaraju &= CC(ring).size() == 1;
+    report("CC_T Kosaraju", kosaraju);
+    report("CC_T Kosaraju CSR", kosarajuCSR);
+
+    // Экономные Тарьян и Габов: те же номера, что у SCTar_T и SCGab_T, в том числе после solve() на изменённом графе.
+    bool tarLean = true, gabLean = true;
+    for (int i = 0; i < 300; i++) {
+        const size_t n = 1 + rnd() % 200;
+        SparseGraphD g = randomDigraph(rnd, n, rnd() % (3 * n + 1));
+        auto tar = SCTarLean(g);
+        auto gab = SCGabLean(g);
+        tarLean &= samePartition(tar, g) && sameIds(tar, SCTar(g), n);
+        gabLean &= samePartition(gab, g) && sameIds(gab, SCGab(g), n);
+        g.insert({rnd() % n, rnd() % n});
+        tar.solve();
+        gab.solve();
+        tarLean &= sameIds(tar, SCTar(g), n);
+        gabLean &= sameIds(gab, SCGab(g), n);
+    }
+    report("SCTarLean_T", tarLean);
+    report("SCGabLean_T", gabLean);
+    report("IncrementalSC", incrementalSC(rnd));
+
+    // Малый порог передачи Тарьяну: обрезка тривиальных компонент и FW-BW работают и на небольших графах.
+    bool par = true;
+    for (int i = 0; i < 300; i++) {
+        const size_t n = 1 + rnd() % 300;
+        SparseGraphD g = randomDigraph(rnd, n, rnd() % (2 * n + 1));
+        par &= samePartition(SCPar_T<SparseGraphD>(g, 1 + rnd() % 8), g);
+    }
+    report("SCPar_T", par);
+}
@@ -17,6 +17,9 @@
 #include <deque>
 #include <stack>
 #include <queue>
+#include <memory>
+#include <cstdint>
+#include "csrGraph.h"
 
 namespace Graph {
 	
@@ -322,73 +325,342 @@ namespace Graph {
     template <class G, class I>
     ArtPoint_T<G,I> ArtPoints(const G& g, I& i) { return ArtPoint_T<G,I>(g,i); }
     
+    ///////////////////////////////////////////////////////////////////////////
+    // Счётчики путей для CountBFS_T и CountBiBFS_T.
+    // Количество кратчайших путей растёт экспоненциально с их длиной и на плотных графах быстро переполняет size_t.
+    
+    // Насыщающийся счётчик. При переполнении остаётся равным максимальному значению.
+    struct SaturatingCount {
+        static constexpr uint64_t MAX = numeric_limits<uint64_t>::max();
+        uint64_t n;
+        SaturatingCount(uint64_t n = 0) : n(n) {}
+        SaturatingCount& operator+=(const SaturatingCount& c) { n = n > MAX - c.n ? MAX : n + c.n; return *this; }
+        friend SaturatingCount operator*(const SaturatingCount& l, const SaturatingCount& r) {
+            uint64_t m;
+            return __builtin_mul_overflow(l.n, r.n, &m) ? MAX : m;
+        }
+        bool operator==(const SaturatingCount& c) const { return n == c.n; }
+        bool saturated() const { return n == MAX; }
+        friend ostream& operator<<(ostream& os, const SaturatingCount& c) {
+            return c.saturated() ? os << ">=" << c.n : os << c.n;
+        }
+    };
+    
+    // 128-битный счётчик.
+    struct WideCount {
+        unsigned __int128 n;
+        WideCount(unsigned __int128 n = 0) : n(n) {}
+        WideCount& operator+=(const WideCount& c) { n += c.n; return *this; }
+        friend WideCount operator*(const WideCount& l, const WideCount& r) { return l.n * r.n; }
+        bool operator==(const WideCount& c) const { return n == c.n; }
+        friend ostream& operator<<(ostream& os, const WideCount& c) {
+            string s;
+            unsigned __int128 n = c.n;
+            do { s += char('0' + int(n % 10)); n /= 10; } while (n != 0);
+            return os << string(s.rbegin(), s.rend());
+        }
+    };
+    
+    // Счётчик по модулю M.
+    template <uint64_t M = 1000000007> struct ModularCount {
+        uint64_t n;
+        ModularCount(uint64_t n = 0) : n(n % M) {}
+        ModularCount& operator+=(const ModularCount& c) { n = (n + c.n) % M; return *this; }
+        friend ModularCount operator*(const ModularCount& l, const ModularCount& r) {
+            return uint64_t((unsigned __int128)l.n * r.n % M);
+        }
+        bool operator==(const ModularCount& c) const { return n == c.n; }
+        friend ostream& operator<<(ostream& os, const ModularCount& c) { return os << c.n; }
+    };
+    
     ///////////////////////////////////////////////////////////////////////////
     // Вычисление количества кратчайших путей между вершинами А и В. O(V+E)
     // Считаем количество заходов в вершины по кратчайшим путям.
-    template <class Graph>
+    // Обход идёт по уровням: количество путей в вершину уровня d окончательно после просмотра всего уровня d-1.
+    // Count - тип счётчика путей: size_t, SaturatingCount, WideCount, ModularCount<M>.
+    template <class Graph, class Count = size_t>
     class CountBFS_T {
         const Graph& g;
-        queue<size_t> q; // очередь просмотра вершин.
-        struct VertexState {
-            size_t count;
-            bool leave;
-            VertexState() : count(0), leave(false) {}
-            friend ostream& operator<<(ostream& os, const VertexState& v) {
-                os << v.count << ":" << v.leave;
-                return os;
-            };
-        };
-        vector<VertexState> state; // вектор количества захода в i-ю вершину.
-        vector<size_t> currentDepth;
+        vector<size_t> depth; // уровень вершины, -1 - вершина не посещена.
+        vector<Count> count; // количество кратчайших путей в вершину.
+        vector<char> target; // отметки искомых вершин.
+        vector<size_t> frontier, next; // текущий и следующий уровни.
     public:
-        CountBFS_T(const Graph& g) : g(g), state(g.size()), currentDepth(g.size()) {}
-        
-        size_t solve (size_t a, size_t b) {
-            state.assign(g.size(), VertexState());
-            currentDepth.clear();
-            q.push(a);
-            state[a].count = 1;
-            state[a].leave = true;
-            size_t currentCount = 0;
-            size_t nextCount = 0;
+        CountBFS_T(const Graph& g) : g(g), depth(g.size(), -1), count(g.size()), target(g.size()) {}
+        
+        // Количества кратчайших путей из a в каждую из вершин targets за один обход.
+        // Обход останавливается на уровне последней достигнутой цели.
+        vector<Count> solve (size_t a, const vector<size_t>& targets) {
+            depth.assign(g.size(), -1);
+            count.assign(g.size(), Count(0));
+            size_t pending = 0; // количество различных ещё не достигнутых целей.
+            for (size_t b : targets) {
+                if (!target[b]) pending++;
+                target[b] = true;
+            }
             
-            while (!q.empty()) {
-                a = q.front(); q.pop();
-                size_t count = state[a].count;
-                if (a == b) {
-                    // Дошли до B
-                    return count;
+            frontier.assign(1, a);
+            depth[a] = 0;
+            count[a] = Count(1);
+            for (size_t d = 0; !frontier.empty(); d++) {
+                // Количества путей в вершины уровня d окончательны.
+                for (size_t v : frontier) {
+                    if (target[v]) pending--;
                 }
-                for (size_t i : g.adjacent(a)) {
-                    VertexState& vs = state[i];
-                    if (vs.leave) continue; // Вершина принадлежит предыдущим ребрам пути.
-                    if(vs.count == 0) {
-                        // Первый заход в i.
-                        q.push(i);
-                        nextCount++;
+                if (pending == 0) break;
+                next.clear();
+                for (size_t v : frontier) {
+                    for (size_t w : g.adjacent(v)) {
+                        if (depth[w] == -1) {
+                            // Первый заход в w.
+                            depth[w] = d + 1;
+                            next.push_back(w);
+                        }
+                        if (depth[w] == d + 1) {
+                            count[w] += count[v];
+                        }
                     }
-                    vs.count += count;
-                    currentDepth.push_back(i);
                 }
-                if (currentCount == 0) {
-                    currentCount = nextCount - 1;
-                    nextCount = 0;
-                    for (auto v : currentDepth) {
-                        state[v].leave = true;
+                swap(frontier, next);
+            }
+            
+            vector<Count> result;
+            result.reserve(targets.size());
+            for (size_t b : targets) {
+                result.push_back(depth[b] != -1 ? count[b] : Count(0));
+                target[b] = false;
+            }
+            return result;
+        }
+        
+        Count solve (size_t a, size_t b) { return solve(a, vector<size_t>{b})[0]; }
+    };
+    
+    // Ускоритель вызова.
+    template <class Count = size_t, class G>
+    CountBFS_T<G, Count> countBFS(const G& g) { return CountBFS_T<G, Count>(g); }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    // Двунаправленное вычисление количества кратчайших путей между вершинами А и В.
+    // Обходы в ширину из A по исходящим рёбрам и из B по входящим рёбрам расширяются по целым уровням,
+    // каждый раз расширяется меньший фронт. Пусть после расширения уровня df прямого обхода
+    // в нём впервые появились вершины, посещённые обратным обходом на глубине db. Тогда кратчайшее расстояние df + db,
+    // каждый кратчайший путь проходит ровно через одну вершину v этого уровня и количество путей
+    // равно сумме countA[v] * countB[v] по таким вершинам.
+    // Просматривается ~O(sqrt) вершин полного обхода на графах с равномерным ветвлением.
+    // Буферы переиспользуются между запросами, сбрасываются только посещённые вершины.
+    template <class Graph, class Count = size_t>
+    class CountBiBFS_T {
+        using Reverse = CSRGraph_T<DirectedGraphTraits>;
+        
+        // Состояние обхода одного направления.
+        struct Side {
+            vector<size_t> depth;
+            vector<Count> count;
+            vector<size_t> frontier, touched;
+            size_t level = 0;
+            Side(size_t n) : depth(n, -1), count(n) {}
+            
+            void start(size_t v) {
+                depth[v] = 0;
+                count[v] = Count(1);
+                frontier.assign(1, v);
+                touched.assign(1, v);
+                level = 0;
+            }
+            
+            void reset() {
+                for (size_t v : touched) {
+                    depth[v] = -1;
+                    count[v] = Count(0);
+                }
+                touched.clear();
+                frontier.clear();
+            }
+        };
+        
+        const Graph& g;
+        unique_ptr<Reverse> r; // индекс входящих рёбер ориентированного графа.
+        Side forward, backward;
+        vector<size_t> next;
+        size_t dist = -1;
+        
+        // Расширяет фронт s на один уровень. Возвращает количество путей через вершины нового уровня,
+        // посещённые встречным обходом o.
+        template <class AG> Count expand_(const AG& ag, Side& s, const Side& o, bool& met) {
+            next.clear();
+            const size_t d = s.level + 1;
+            for (size_t v : s.frontier) {
+                for (size_t w : ag.adjacent(v)) {
+                    if (s.depth[w] == -1) {
+                        s.depth[w] = d;
+                        next.push_back(w);
+                    }
+                    if (s.depth[w] == d) {
+                        s.count[w] += s.count[v];
                     }
-                    currentDepth.clear();
-                    // cout << state;
+                }
+            }
+            swap(s.frontier, next);
+            s.touched.insert(s.touched.end(), s.frontier.begin(), s.frontier.end());
+            s.level = d;
+            
+            Count paths(0);
+            met = false;
+            for (size_t v : s.frontier) {
+                if (o.depth[v] != -1) {
+                    met = true;
+                    paths += s.count[v] * o.count[v];
+                }
+            }
+            return paths;
+        }
+        
+    public:
+        CountBiBFS_T(const Graph& g) : g(g), forward(g.size()), backward(g.size()) {
+            if (g.directed()) r.reset(new Reverse(g, true));
+        }
+        
+        // Количество кратчайших путей из a в b.
+        Count solve(size_t a, size_t b) {
+            forward.reset();
+            backward.reset();
+            dist = -1;
+            if (a == b) {
+                dist = 0;
+                return Count(1);
+            }
+            forward.start(a);
+            backward.start(b);
+            bool met = false;
+            while (!forward.frontier.empty() && !backward.frontier.empty()) {
+                Count paths(0);
+                if (forward.frontier.size() <= backward.frontier.size()) {
+                    paths = expand_(g, forward, backward, met);
+                } else if (r) {
+                    paths = expand_(*r, backward, forward, met);
+                } else {
+                    paths = expand_(g, backward, forward, met);
+                }
+                if (met) {
+                    dist = forward.level + backward.level;
+                    return paths;
+                }
+            }
+            return Count(0);
+        }
+        
+        // Длина кратчайшего пути последнего запроса. -1 если пути нет.
+        size_t distance() const { return dist; }
+    };
+    
+    // Ускоритель вызова.
+    template <class Count = size_t, class G>
+    CountBiBFS_T<G, Count> countBiBFS(const G& g) { return CountBiBFS_T<G, Count>(g); }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    // Кратчайший по количеству рёбер путь между двумя вершинами. Двунаправленный BFS.
+    // Обходы из A по исходящим рёбрам и из B по входящим рёбрам расширяются по уровням, каждый раз меньший фронт.
+    // Если до расширения очередного уровня обходы не встречались, то первая же вершина нового уровня,
+    // посещённая встречным обходом, лежит на кратчайшем пути и поиск сразу останавливается.
+    // Буферы выделяются один раз. Отметки посещения - номера запросов (epoch), поэтому сброс между запросами O(1).
+    // Epoch - тип номера запроса. При его переполнении отметки сбрасываются, O(V) раз в 2^32 запросов для uint32_t.
+    // Для многопоточного использования - по экземпляру на поток.
+    template <class Graph, class Epoch = uint32_t>
+    class BiBFS_T {
+        using Reverse = CSRGraph_T<DirectedGraphTraits>;
+        
+        // Состояние обхода одного направления.
+        struct Side {
+            vector<Epoch> seen; // номер запроса, в котором вершина посещена.
+            vector<size_t> parent; // предыдущая вершина на пути от начала обхода.
+            vector<size_t> frontier;
+            size_t level = 0;
+            Side(size_t n) : seen(n), parent(n) {}
+        };
+        
+        const Graph& g;
+        unique_ptr<Reverse> r; // индекс входящих рёбер ориентированного графа.
+        Side forward, backward;
+        vector<size_t> next;
+        Epoch epoch = 0;
+        vector<size_t> p; // путь последнего запроса.
+        
+        void visit_(Side& s, size_t v, size_t parent) {
+            s.seen[v] = epoch;
+            s.parent[v] = parent;
+        }
+        
+        // Расширяет фронт s на один уровень. Возвращает вершину встречи или -1.
+        template <class AG> size_t expand_(const AG& ag, Side& s, const Side& o) {
+            next.clear();
+            for (size_t v : s.frontier) {
+                for (size_t w : ag.adjacent(v)) {
+                    if (s.seen[w] == epoch) continue;
+                    visit_(s, w, v);
+                    if (o.seen[w] == epoch) return w;
+                    next.push_back(w);
+                }
+            }
+            swap(s.frontier, next);
+            s.level++;
+            return -1;
+        }
+        
+        // Путь через вершину встречи m.
+        void path_(size_t m) {
+            for (size_t v = m; v != -1; v = forward.parent[v]) p.push_back(v);
+            reverse(p.begin(), p.end());
+            for (size_t v = backward.parent[m]; v != -1; v = backward.parent[v]) p.push_back(v);
+        }
+        
+    public:
+        BiBFS_T(const Graph& g) : g(g), forward(g.size()), backward(g.size()) {
+            if (g.directed()) r.reset(new Reverse(g, true));
+        }
+        
+        // Длина кратчайшего пути из a в b. -1 если пути нет.
+        size_t solve(size_t a, size_t b) {
+            p.clear();
+            if (++epoch == Epoch(0)) {
+                // Переполнение номера запроса. Сбрасываем отметки.
+                fill(forward.seen.begin(), forward.seen.end(), 0);
+                fill(backward.seen.begin(), backward.seen.end(), 0);
+                epoch = 1;
+            }
+            visit_(forward, a, -1);
+            visit_(backward, b, -1);
+            forward.frontier.assign(1, a);
+            backward.frontier.assign(1, b);
+            forward.level = backward.level = 0;
+            
+            size_t m = a == b ? a : -1;
+            while (m == -1 && !forward.frontier.empty() && !backward.frontier.empty()) {
+                if (forward.frontier.size() <= backward.frontier.size()) {
+                    m = expand_(g, forward, backward);
+                } else if (r) {
+                    m = expand_(*r, backward, forward);
                 } else {
-                    currentCount--;
+                    m = expand_(g, backward, forward);
                 }
             }
-            return 0;
+            if (m == -1) return -1;
+            path_(m);
+            return p.size() - 1;
         }
+        
+        // Вершины кратчайшего пути последнего запроса от a до b. Пустой если пути нет.
+        const vector<size_t>& path() const { return p; }
+        
+        // Вершины кратчайшего пути из a в b.
+        const vector<size_t>& path(size_t a, size_t b) { solve(a, b); return p; }
     };
     
     // Ускоритель вызова.
     template <class G>
-    CountBFS_T<G> countBFS(const G& g) { return CountBFS_T<G>(g); }
+    BiBFS_T<G> biBFS(const G& g) { return BiBFS_T<G>(g); }
 }
 
+void searchTest();
+
 #endif /* search_h */
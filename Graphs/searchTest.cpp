@@ -0,0 +1,183 @@
+//
+//  searchTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сверка обходов в ширину с обычным BFS из одной вершины на случайных графах.
+
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+#include "debug.h"
+#include "sparseGraph.h"
+#include "searchGraph.h"
+#include "msBFS.h"
+
+using namespace std;
+using namespace Graph;
+
+// Расстояния от s до всех вершин обычным обходом в ширину, -1 для недостижимых.
+template <class G> static vector<size_t> bfsDistances(const G& g, size_t s) {
+    vector<size_t> d(g.size(), -1);
+    vector<size_t> queue(1, s);
+    d[s] = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        size_t v = queue[i];
+        for (size_t w : g.adjacent(v)) {
+            if (d[w] == -1) {
+                d[w] = d[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return d;
+}
+
+// Количества кратчайших путей из s до всех вершин: BFS, затем проход вершин по возрастанию расстояния.
+template <class G> static vector<size_t> pathCounts(const G& g, size_t s) {
+    auto d = bfsDistances(g, s);
+    vector<size_t> order;
+    for (size_t v = 0; v < g.size(); v++) if (d[v] != -1) order.push_back(v);
+    stable_sort(order.begin(), order.end(), [&d](size_t v, size_t w) { return d[v] < d[w]; });
+    vector<size_t> c(g.size());
+    c[s] = 1;
+    for (size_t v : order) {
+        for (size_t w : g.adjacent(v)) {
+            if (d[w] == d[v] + 1) c[w] += c[v];
+        }
+    }
+    return c;
+}
+
+template <class G> static G randomGraph(mt19937& rnd, size_t n, size_t m) {
+    G g(n);
+    for (size_t k = 0; k < m; k++) g.insert({rnd() % n, rnd() % n});
+    return g;
+}
+
+// Таблица MSBFS_T по источникам больше чем на одну пачку, с повторами, сверяется с BFS из каждого источника.
+template <size_t Lanes, class G> static bool msBFSDistances(mt19937& rnd, const G& g) {
+    vector<size_t> sources(Lanes + 1 + rnd() % (2 * Lanes));
+    for (size_t& s : sources) s = rnd() % g.size();
+    auto d = msBFS<Lanes>(g).distances(sources);
+    for (size_t i = 0; i < sources.size(); i++) {
+        if (d[i] != bfsDistances(g, sources[i])) return false;
+    }
+    return true;
+}
+
+// Количества путей CountBFS_T и CountBiBFS_T, а также distance(), сверяются с перебором для всех пар вершин.
+// Запрос нескольких целей сразу с повторами, недостижимыми целями и самим началом совпадает с поодиночными.
+template <class G> static bool countPaths(mt19937& rnd, const G& g) {
+    const size_t n = g.size();
+    auto c = countBFS(g);
+    auto bc = countBiBFS(g);
+    for (size_t a = 0; a < n; a++) {
+        auto d = bfsDistances(g, a);
+        auto expected = pathCounts(g, a);
+        for (size_t b = 0; b < n; b++) {
+            if (c.solve(a, b) != expected[b] || bc.solve(a, b) != expected[b] || bc.distance() != d[b]) return false;
+        }
+        vector<size_t> targets(1 + rnd() % 8);
+        for (size_t& b : targets) b = rnd() % n;
+        targets.push_back(a);
+        targets.push_back(targets[0]);
+        auto counts = c.solve(a, targets);
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (counts[i] != expected[targets[i]]) return false;
+        }
+    }
+    return true;
+}
+
+// Длины BiBFS_T для всех пар вершин совпадают с BFS, путь идёт из a в b по рёбрам графа и содержит solve() + 1 вершин.
+// Узкий тип номера запроса в BB позволяет пройти через его переполнение за небольшое число запросов.
+template <class BB, class G> static bool biBFSPaths(const G& g) {
+    BB bb(g);
+    for (size_t a = 0; a < g.size(); a++) {
+        auto d = bfsDistances(g, a);
+        for (size_t b = 0; b < g.size(); b++) {
+            const size_t len = bb.solve(a, b);
+            const auto& p = bb.path();
+            if (len != d[b]) return false;
+            if (len == -1) {
+                if (!p.empty()) return false;
+                continue;
+            }
+            if (p.size() != len + 1 || p.front() != a || p.back() != b) return false;
+            for (size_t i = 0; i + 1 < p.size(); i++) {
+                auto adj = g.adjacent(p[i]);
+                if (find(adj.begin(), adj.end(), p[i + 1]) == adj.end()) return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Цепочка из k ромбов: 2^k кратчайших путей из 0 в последнюю вершину.
+static SparseGraph diamonds(size_t k) {
+    SparseGraph g(3 * k + 1);
+    for (size_t i = 0; i < k; i++) {
+        g.insert({3 * i, 3 * i + 1});
+        g.insert({3 * i, 3 * i + 2});
+        g.insert({3 * i + 1, 3 * i + 3});
+        g.insert({3 * i + 2, 3 * i + 3});
+    }
+    return g;
+}
+
+static bool countOverflow() {
+    const size_t k = 70, b = 3 * k;
+    auto g = diamonds(k);
+    const unsigned __int128 paths = (unsigned __int128)1 << k;
+    bool ok = countBFS(g).solve(0, b) == size_t(paths); // size_t переполняется.
+    ok &= countBFS<SaturatingCount>(g).solve(0, b).saturated();
+    ok &= countBiBFS<SaturatingCount>(g).solve(0, b).saturated();
+    ok &= countBFS<WideCount>(g).solve(0, b) == WideCount(paths);
+    ok &= countBiBFS<WideCount>(g).solve(0, b) == WideCount(paths);
+    ok &= countBiBFS<ModularCount<>>(g).solve(0, b) == ModularCount<>(uint64_t(paths % 1000000007));
+    // На 63 ромбах переполнения ещё нет.
+    ok &= !countBFS<SaturatingCount>(diamonds(63)).solve(0, 3 * 63).saturated();
+    return ok;
+}
+
+void searchTest()
+{
+    mt19937 rnd(26);
+    bool ms = true;
+    for (int i = 0; i < 30; i++) {
+        const size_t n = 1 + rnd() % 300, m = rnd() % (2 * n + 1);
+        auto g = randomGraph<SparseGraph>(rnd, n, m);
+        auto dg = randomGraph<SparseGraphD>(rnd, n, m);
+        ms &= msBFSDistances<64>(rnd, g) && msBFSDistances<128>(rnd, g);
+        ms &= msBFSDistances<64>(rnd, dg) && msBFSDistances<128>(rnd, dg);
+    }
+    report("MSBFS_T", ms);
+
+    // Ромб 0-1-3, 0-2-3 с ребром 1-2 между соседними вершинами одного уровня: оно не добавляет путей.
+    SparseGraph rhomb(4);
+    for (auto e : {GraphEdge(0, 1), GraphEdge(0, 2), GraphEdge(1, 2), GraphEdge(1, 3), GraphEdge(2, 3)}) rhomb.insert(e);
+    bool count = countBFS(rhomb).solve(0, 3) == 2 && countBiBFS(rhomb).solve(0, 3) == 2;
+    count &= countBFS(rhomb).solve(0, 1) == 1 && countBiBFS(rhomb).solve(1, 2) == 1 && countPaths(rnd, rhomb);
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 1 + rnd() % 40, m = rnd() % (3 * n + 1);
+        count &= countPaths(rnd, randomGraph<SparseGraph>(rnd, n, m));
+        count &= countPaths(rnd, randomGraph<SparseGraphD>(rnd, n, m));
+    }
+    report("CountBFS_T, CountBiBFS_T", count);
+    report("Count overflow", countOverflow());
+
+    // Ориентированные графы обходятся от b по входящим рёбрам. Номер запроса uint8_t переполняется каждые 255 запросов.
+    bool bi = true;
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 1 + rnd() % 40, m = rnd() % (2 * n + 1);
+        auto g = randomGraph<SparseGraph>(rnd, n, m);
+        auto dg = randomGraph<SparseGraphD>(rnd, n, m);
+        bi &= biBFSPaths<BiBFS_T<SparseGraph>>(g) && biBFSPaths<BiBFS_T<SparseGraphD>>(dg);
+        bi &= biBFSPaths<BiBFS_T<SparseGraph, uint8_t>>(g) && biBFSPaths<BiBFS_T<SparseGraphD, uint8_t>>(dg);
+    }
+    report("BiBFS_T", bi);
+}
@@ -64,6 +64,10 @@ namespace Graph {
 		
         // Кол-во ребер
         size_t edgesCount() const { prepare_(); return _edges; }
+
+        // Списки смежности сортируются и очищаются от дубликатов лениво, при первом чтении после вставки.
+        // Эта запись не потокобезопасна, поэтому перед параллельным чтением граф готовится явно.
+        void prepare() const { prepare_(); }
 		
 		constexpr bool directed() const { return Traits::directed; }
 		
@@ -14,12 +14,19 @@
 #include <limits>
 #include <algorithm>
 #include <queue>
+#include <cstdint>
 #include <assert.h>
+#include "heap.h"
+#include "csrGraph.h"
+#include "parallel.h"
+#include "debug.h"
 
 namespace Graph {
     // Алгоритм поиска кратчайших путей Дейкстры. Седжвик 21.1 O(E*lg(V))
     // Также реализует функцию поиска наиболее удаленной вершины для решения задачи вычисления диаметра Графа.
-    template<typename G> class SptDijkstra_T {
+    // Queue - очередь вершин с уменьшением ключа из heap.h. По умолчанию индексная 4-ичная куча: не больше V элементов
+    // и уменьшение ключа на месте. RadixHeap_T быстрее на целых весах, но требует неотрицательных весов.
+    template<typename G, class Queue = DaryHeap_T<typename G::Traits::WeightType>> class SptDijkstra_T {
         using Traits = typename G::Traits;
         using Edge = typename Traits::EdgeType;
         using Weight = typename Traits::WeightType;
@@ -35,12 +42,9 @@ namespace Graph {
         // Priority-first search.
         void pfs_(size_t s) {
             _distance[s] = 0.; // Установим в начальную точку пути нулевой вес.
-            // Очередь вершин по приоритету возрастания веса.
-            auto compare = [this](size_t l, size_t r)->bool
-            { return this->_distance[l] > this->_distance[r]; };
-            
-            std::priority_queue<size_t, std::vector<size_t>, decltype(compare)> pfsQueue(compare);
-            pfsQueue.push(s);
+            // Очередь вершин по приоритету возрастания веса. Ключ вершины в очереди равен _distance.
+            Queue pfsQueue(_g.size());
+            pfsQueue.push(s, _distance[s]);
             
             size_t farest = s; // Наиболее удаленная вершина от v.
             
@@ -48,11 +52,10 @@ namespace Graph {
             vector<bool> used(_g.size());
             
             while (!pfsQueue.empty()) {
-                const size_t v = pfsQueue.top(); pfsQueue.pop();
+                const size_t v = pfsQueue.pop();
                 
                 if (v == _finish) return;
 
-                if (used[v]) continue;
                 used[v] = true;
                 
                 const Weight distanceV = _distance[v];
@@ -68,8 +71,8 @@ namespace Graph {
                         // Корректируем spt.
                         _parent[w] = v;
                         _distance[w] = distance;
-                        // Нестрашно повтороное занесение вершины, поскольку выберется вершина один раз с минимальным весом.
-                        pfsQueue.push(w); // lg(V).
+                        // Вставка или уменьшение ключа вершины в очереди.
+                        if (!used[w]) pfsQueue.push(w, distance);
                         
                         // Вычисляем наиболее удаленную вершину.
                         if (distance > _distance[farest]) {
@@ -130,7 +133,266 @@ namespace Graph {
     
     // Ускоритель вызова
     template<typename G> SptDijkstra_T<G> sptDijkstra(const G& g, size_t a, size_t b = -1) { return {g, a, b}; }
-    
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Многоразовый движок запросов Дейкстры для потока запросов к одному графу.
+    // Буферы размера V выделяются один раз в конструкторе. Метки вершин помечаются номером запроса (эпохой):
+    // метка с чужой эпохой считается пустой, поэтому сброс между запросами - O(1), а запрос пишет только
+    // в достигнутые вершины. Очередь очищается за O(размера остатка).
+    // Объект не потокобезопасен: один движок на поток. Граф читается совместно и готовится к этому в конструкторе,
+    // поэтому движки создаются до запуска потоков или копируются.
+    template<typename G, class Queue = DaryHeap_T<typename G::Traits::WeightType>> class DijkstraEngine_T {
+        using Traits = typename G::Traits;
+        using Edge = typename Traits::EdgeType;
+        using Weight = typename Traits::WeightType;
+        static constexpr size_t NONE = size_t(-1);
+
+        struct Label {
+            Weight distance;
+            size_t parent;
+            uint32_t reached = 0; // Эпоха, в которой вершина достигнута.
+            uint32_t settled = 0; // Эпоха, в которой расстояние до вершины окончательно.
+        };
+
+        const G& _g;
+        vector<Label> _labels;
+        Queue _queue;
+        vector<size_t> _settledList; // Окончательные вершины текущего запроса в порядке возрастания расстояния.
+        uint32_t _epoch = 0;
+        size_t _source = NONE;
+
+        void nextEpoch_() {
+            if (++_epoch == 0) {
+                for (auto& l : _labels) l.reached = l.settled = 0;
+                _epoch = 1;
+            }
+            _queue.clear();
+            _settledList.clear();
+        }
+
+        // Поиск из s до окончательной t (NONE - без цели) по вершинам на расстоянии не больше radius.
+        void search_(size_t s, size_t t, Weight radius) {
+            nextEpoch_();
+            _source = s;
+            _labels[s].distance = 0;
+            _labels[s].parent = NONE;
+            _labels[s].reached = _epoch;
+            _queue.push(s, 0);
+            while (!_queue.empty()) {
+                const size_t v = _queue.pop();
+                Label& lv = _labels[v];
+                lv.settled = _epoch;
+                _settledList.push_back(v);
+                if (v == t) return;
+                for (auto node : _g.adjacent(v)) {
+                    const size_t w = node.dest;
+                    const Weight distance = lv.distance + node.weight;
+                    if (distance > radius) continue;
+                    Label& lw = _labels[w];
+                    if (lw.reached != _epoch) {
+                        lw.reached = _epoch;
+                    } else if (lw.settled == _epoch || !(distance < lw.distance)) {
+                        continue;
+                    }
+                    lw.distance = distance;
+                    lw.parent = v;
+                    _queue.push(w, distance);
+                }
+            }
+        }
+
+    public:
+        const Weight INF = std::numeric_limits<Weight>::max();
+
+        DijkstraEngine_T(const G& g) : _g(g), _labels(g.size()), _queue(g.size()) {
+            trace("DijkstraEngine_T");
+            prepareForParallel(g);
+        }
+
+        // Кратчайший путь s -> t. Поиск останавливается, когда расстояние до t окончательно.
+        // Возвращает расстояние или INF, если t недостижима.
+        Weight query(size_t s, size_t t) {
+            search_(s, t, INF);
+            return distance(t);
+        }
+
+        // Дерево кратчайших путей из s во все вершины.
+        void queryAll(size_t s) { search_(s, NONE, INF); }
+
+        // Изохрона: все вершины на расстоянии не больше radius от s. Возвращает их в порядке возрастания расстояния.
+        const vector<size_t>& queryRadius(size_t s, Weight radius) {
+            search_(s, NONE, radius);
+            return _settledList;
+        }
+
+        // Результаты последнего запроса.
+        size_t source() const { return _source; }
+
+        // Расстояние до v окончательно (для queryAll и queryRadius - вершина достижима).
+        bool settled(size_t v) const { return _epoch != 0 && _labels[v].settled == _epoch; }
+
+        // Окончательные вершины в порядке возрастания расстояния.
+        const vector<size_t>& settledVertices() const { return _settledList; }
+
+        // Расстояние до окончательной вершины, иначе INF.
+        Weight distance(size_t v) const { return settled(v) ? _labels[v].distance : INF; }
+
+        // Исток последнего ребра кратчайшего пути в окончательную вершину, иначе -1.
+        size_t source(size_t v) const { return settled(v) ? _labels[v].parent : NONE; }
+
+        // Кратчайший путь в окончательную вершину w в форме SptDijkstra_T::spt(w). Пустой, если w не окончательна.
+        std::vector<Edge> spt(size_t w) const {
+            std::vector<Edge> spt;
+            if (!settled(w)) return spt;
+            for (auto v = _labels[w].parent; v != NONE; w = v, v = _labels[w].parent) {
+                spt.push_back({v, {w, _labels[w].distance}});
+            }
+            reverse(spt.begin(), spt.end());
+            return spt;
+        }
+    };
+
+    // Ускоритель вызова.
+    template<typename G> DijkstraEngine_T<G> dijkstraEngine(const G& g) { return {g}; }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Двунаправленный поиск Дейкстры s -> t. Прямой поиск из s и обратный из t (по входящим рёбрам, для орграфа -
+    // по транспонированной копии CSR) выполняют шаги по очереди. mu - длина лучшего найденного пути через ребро между
+    // достигнутыми вершинами двух поисков. Поиск останавливается, когда сумма расстояний последних окончательных
+    // вершин обоих поисков не меньше mu: более короткий путь прошёл бы через вершину, ещё не извлечённую ни одним из них.
+    // На дорожных графах оба шара вместе примерно вдвое меньше шара однонаправленного поиска.
+    // Буферы многоразовые с эпохами, как в DijkstraEngine_T: один объект на поток.
+    template<typename G, class Queue = DaryHeap_T<typename G::Traits::WeightType>> class BiDijkstra_T {
+        using Traits = typename G::Traits;
+        using Edge = typename Traits::EdgeType;
+        using Weight = typename Traits::WeightType;
+        static constexpr size_t NONE = size_t(-1);
+
+        struct Label {
+            Weight distance;
+            size_t parent; // Для обратного поиска - следующая вершина пути к t.
+            uint32_t reached = 0;
+            uint32_t settled = 0;
+        };
+
+        // Состояние одного из поисков.
+        struct Side {
+            vector<Label> labels;
+            Queue queue;
+            Weight radius = 0; // Расстояние последней окончательной вершины.
+            Side(size_t n) : labels(n), queue(n) {}
+        };
+
+        const G& _g;
+        const CSRGraph_T<Traits> _in; // Входящие рёбра орграфа. Для неориентированного графа пуст.
+        Side _forward, _backward;
+        uint32_t _epoch = 0;
+        size_t _settled = 0;
+        Weight _mu;
+        size_t _meetF = NONE, _meetB = NONE; // Ребро лучшего пути между прямым и обратным поиском.
+
+        void start_(Side& x, size_t s) {
+            x.queue.clear();
+            x.radius = 0;
+            x.labels[s].distance = 0;
+            x.labels[s].parent = NONE;
+            x.labels[s].reached = _epoch;
+            x.queue.push(s, 0);
+        }
+
+        // Шаг поиска x по графу h: извлечение вершины и релаксация её рёбер. y - встречный поиск.
+        // Возвращает false, если поиск можно остановить.
+        template <class H> bool step_(const H& h, Side& x, Side& y, bool forward) {
+            if (x.queue.empty()) return false;
+            const size_t v = x.queue.pop();
+            Label& lv = x.labels[v];
+            lv.settled = _epoch;
+            _settled++;
+            x.radius = lv.distance;
+            if (!(x.radius + y.radius < _mu)) return false;
+            for (auto node : h.adjacent(v)) {
+                const size_t w = node.dest;
+                const Weight distance = lv.distance + node.weight;
+                const Label& ly = y.labels[w];
+                if (ly.reached == _epoch && distance + ly.distance < _mu) {
+                    _mu = distance + ly.distance;
+                    _meetF = forward ? v : w;
+                    _meetB = forward ? w : v;
+                }
+                Label& lw = x.labels[w];
+                if (lw.reached != _epoch) {
+                    lw.reached = _epoch;
+                } else if (lw.settled == _epoch || !(distance < lw.distance)) {
+                    continue;
+                }
+                lw.distance = distance;
+                lw.parent = v;
+                x.queue.push(w, distance);
+            }
+            return true;
+        }
+
+        bool stepBackward_() {
+            if constexpr (Traits::directed) return step_(_in, _backward, _forward, false);
+            else return step_(_g, _backward, _forward, false);
+        }
+
+    public:
+        const Weight INF = std::numeric_limits<Weight>::max();
+
+        BiDijkstra_T(const G& g) : _g(g),
+            _in(Traits::directed ? CSRGraph_T<Traits>(g, true) : CSRGraph_T<Traits>(0, vector<Edge>())),
+            _forward(g.size()), _backward(g.size()), _mu(std::numeric_limits<Weight>::max()) {
+            trace("BiDijkstra_T");
+            prepareForParallel(g);
+        }
+
+        // Кратчайший путь s -> t. Возвращает его длину или INF, если t недостижима.
+        Weight query(size_t s, size_t t) {
+            if (++_epoch == 0) {
+                for (Side* x : {&_forward, &_backward})
+                    for (auto& l : x->labels) l.reached = l.settled = 0;
+                _epoch = 1;
+            }
+            _settled = 0;
+            _meetF = _meetB = NONE;
+            start_(_forward, s);
+            start_(_backward, t);
+            _mu = s == t ? 0 : INF;
+            for (bool forward = true; forward ? step_(_g, _forward, _backward, true) : stepBackward_(); forward = !forward);
+            return _mu;
+        }
+
+        // Длина пути последнего запроса.
+        Weight distance() const { return _mu; }
+
+        // Количество вершин, извлечённых из очередей обоими поисками в последнем запросе.
+        size_t settledCount() const { return _settled; }
+
+        // Кратчайший путь последнего запроса в форме SptDijkstra_T::spt(t): рёбра от s к t, вес ребра - расстояние
+        // от s до его конца. Пустой, если t недостижима или совпадает с s.
+        std::vector<Edge> path() const {
+            std::vector<Edge> path;
+            if (_meetF == NONE) return path;
+            const auto& lf = _forward.labels;
+            const auto& lb = _backward.labels;
+            size_t w = _meetF;
+            for (auto v = lf[w].parent; v != NONE; w = v, v = lf[w].parent) {
+                path.push_back({v, {w, lf[w].distance}});
+            }
+            reverse(path.begin(), path.end());
+            path.push_back({_meetF, {_meetB, _mu - lb[_meetB].distance}});
+            size_t v = _meetB;
+            for (auto w = lb[v].parent; w != NONE; v = w, w = lb[v].parent) {
+                path.push_back({v, {w, _mu - lb[w].distance}});
+            }
+            return path;
+        }
+    };
+
+    // Ускоритель вызова.
+    template<typename G> BiDijkstra_T<G> biDijkstra(const G& g) { return {g}; }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Алгоритм поиска кратчайших путей (SPT) Бэллмана-Форда - наивная реализация.
     template<typename G> class SptBFNaive_T {
@@ -307,4 +569,7 @@ namespace Graph {
     
 } // namespace Graph
 
+void sptTest();
+void sptBenchmark();
+
 #endif /* shortestPath_h */
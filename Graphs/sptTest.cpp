@@ -0,0 +1,319 @@
+//
+//  sptTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сравнение очередей с приоритетом в алгоритме Дейкстры на дорожном и социальном графах.
+// Сверка поиска кратчайших путей с алгоритмом Бэллмана-Форда на малых случайных графах.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+
+#include "weightedGraph.h"
+#include "spt.h"
+#include "parallel.h"
+#include "debug.h"
+
+using namespace std;
+using namespace Graph;
+
+// Решётка w x h со случайными целыми весами 1..100: малая степень, большой диаметр, как у дорожной сети.
+static void roadGraph(SparseGraphW& g, size_t w, size_t h, mt19937& rnd) {
+    uniform_int_distribution<int> weight(1, 100);
+    for (size_t y = 0; y < h; y++) {
+        for (size_t x = 0; x < w; x++) {
+            size_t v = y * w + x;
+            if (x + 1 < w) g.insert({v, v + 1, double(weight(rnd))});
+            if (y + 1 < h) g.insert({v, v + w, double(weight(rnd))});
+        }
+    }
+}
+
+// Предпочтительное присоединение (Barabási, Albert): каждая новая вершина соединяется с m вершинами,
+// выбранными пропорционально степени. Степени распределены по степенному закону, диаметр мал.
+static void socialGraph(SparseGraphW& g, size_t m, mt19937& rnd) {
+    uniform_int_distribution<int> weight(1, 100);
+    vector<size_t> ends; // Концы всех рёбер: выбор случайного конца - выбор вершины пропорционально степени.
+    for (size_t v = 1; v <= m; v++) {
+        g.insert({0, v, double(weight(rnd))});
+        ends.push_back(0);
+        ends.push_back(v);
+    }
+    for (size_t v = m + 1; v < g.size(); v++) {
+        for (size_t i = 0; i < m; i++) {
+            size_t w = ends[uniform_int_distribution<size_t>(0, ends.size() - 1)(rnd)];
+            g.insert({v, w, double(weight(rnd))});
+            ends.push_back(v);
+            ends.push_back(w);
+        }
+    }
+}
+
+// Время поиска из всех источников sources в секундах. Сумма расстояний - для сверки результатов.
+template <class Queue> static double measure(const char* name, const SparseGraphW& g, const vector<size_t>& sources) {
+    double sum = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t s : sources) {
+        SptDijkstra_T<SparseGraphW, Queue> spt(g, s);
+        for (size_t v = 0; v < g.size(); v++) sum += spt.distance(v);
+    }
+    cout << setw(20) << name << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s\n";
+    return sum;
+}
+
+static void sptBenchmark(const char* title, const SparseGraphW& g, mt19937& rnd) {
+    cout << "\n" << title << ": V = " << g.size() << ", E = " << g.edgesCount() << "\n";
+    vector<size_t> sources(5);
+    for (auto& s : sources) s = uniform_int_distribution<size_t>(0, g.size() - 1)(rnd);
+    double lazy = measure<LazyQueue_T<double>>("Lazy binary heap", g, sources);
+    double d2 = measure<DaryHeap_T<double, 2>>("Indexed 2-heap", g, sources);
+    double d4 = measure<DaryHeap_T<double, 4>>("Indexed 4-heap", g, sources);
+    double d8 = measure<DaryHeap_T<double, 8>>("Indexed 8-heap", g, sources);
+    double pairing = measure<PairingHeap_T<double>>("Pairing heap", g, sources);
+    double radix = measure<RadixHeap_T<double>>("Radix heap", g, sources);
+    cout << "Equal: " << boolalpha << (lazy == d2 && lazy == d4 && lazy == d8 && lazy == pairing && lazy == radix) << "\n";
+}
+
+// Короткие запросы s-t между близкими вершинами решётки w x h: SptDijkstra_T каждый раз заполняет массивы размера V,
+// DijkstraEngine_T сбрасывает метки сменой эпохи. Параллельно - по движку на поток.
+static void sptQueriesBenchmark(const SparseGraphW& g, size_t w, size_t h, mt19937& rnd) {
+    const size_t queries = 2000, span = 20;
+    vector<pair<size_t, size_t>> pairs(queries);
+    for (auto& p : pairs) {
+        size_t x = rnd() % (w - span), y = rnd() % (h - span);
+        p = {y * w + x, (y + rnd() % span) * w + x + rnd() % span};
+    }
+    cout << "\nPoint-to-point queries: " << queries << ", span " << span << "\n";
+    vector<double> expected(queries), got(queries), par(queries);
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; i++) expected[i] = SptDijkstra_T<SparseGraphW>(g, pairs[i].first, pairs[i].second).distance();
+    cout << setw(20) << "SptDijkstra" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s\n";
+
+    start = chrono::steady_clock::now();
+    auto engine = dijkstraEngine(g);
+    for (size_t i = 0; i < queries; i++) got[i] = engine.query(pairs[i].first, pairs[i].second);
+    cout << setw(20) << "DijkstraEngine" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s\n";
+
+    start = chrono::steady_clock::now();
+    vector<DijkstraEngine_T<SparseGraphW>> engines(threadsCount(), engine);
+    parallelForT(0, queries, [&](size_t i, size_t t) { par[i] = engines[t].query(pairs[i].first, pairs[i].second); }, 64);
+    cout << setw(20) << "Parallel engines" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s\n";
+    cout << "Equal: " << boolalpha << (expected == got && expected == par) << "\n";
+}
+
+// Запросы s-t между случайными вершинами: однонаправленный и двунаправленный поиск, время и окончательные вершины.
+static void biDijkstraBenchmark(const SparseGraphW& g, mt19937& rnd) {
+    const size_t queries = 200;
+    vector<pair<size_t, size_t>> pairs(queries);
+    for (auto& p : pairs) p = {rnd() % g.size(), rnd() % g.size()};
+    cout << "\nRandom s-t queries: " << queries << "\n";
+    bool equal = true;
+
+    auto engine = dijkstraEngine(g);
+    vector<double> expected(queries);
+    size_t settled = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; i++) {
+        expected[i] = engine.query(pairs[i].first, pairs[i].second);
+        settled += engine.settledVertices().size();
+    }
+    cout << setw(20) << "DijkstraEngine" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s, settled " << settled / queries << "\n";
+
+    auto bi = biDijkstra(g);
+    settled = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; i++) {
+        equal &= bi.query(pairs[i].first, pairs[i].second) == expected[i];
+        settled += bi.settledCount();
+    }
+    cout << setw(20) << "BiDijkstra" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s, settled " << settled / queries << "\n";
+    cout << "Equal: " << boolalpha << equal << "\n";
+}
+
+static const double INF = numeric_limits<double>::max();
+
+// Случайный граф с целыми весами 0..9: суммы весов точны, результаты сравниваются на равенство.
+template <class G> static G randomGraph(mt19937& rnd, size_t n, size_t m) {
+    G g(n);
+    for (size_t k = 0; k < m; k++) g.insert({rnd() % n, rnd() % n, double(rnd() % 10)});
+    return g;
+}
+
+// Расстояния из s алгоритмом Бэллмана-Форда по спискам смежности, INF для недостижимых.
+template <class G> static vector<double> bellmanFord(const G& g, size_t s) {
+    vector<double> d(g.size(), INF);
+    d[s] = 0;
+    for (bool relaxed = true; relaxed;) {
+        relaxed = false;
+        for (size_t v = 0; v < g.size(); v++) {
+            if (d[v] == INF) continue;
+            for (auto node : g.adjacent(v)) {
+                if (d[v] + node.weight < d[node.dest]) {
+                    d[node.dest] = d[v] + node.weight;
+                    relaxed = true;
+                }
+            }
+        }
+    }
+    return d;
+}
+
+// Путь из рёбер графа от s к t, вес ребра пути - расстояние от s до его конца. Пустой путь - только при s == t.
+template <class G, class Edge> static bool validPath(const G& g, const vector<Edge>& p, size_t s, size_t t, const vector<double>& d) {
+    if (p.empty()) return s == t;
+    if (p.front().v != s || p.back().w != t) return false;
+    double prev = 0;
+    for (size_t i = 0; i < p.size(); i++) {
+        if (i > 0 && p[i].v != p[i - 1].w) return false;
+        if (p[i].weight != d[p[i].w]) return false;
+        bool edge = false;
+        for (auto node : g.adjacent(p[i].v)) edge |= node.dest == p[i].w && prev + node.weight == p[i].weight;
+        if (!edge) return false;
+        prev = p[i].weight;
+    }
+    return true;
+}
+
+// SptDijkstra_T с очередью Queue: расстояния до всех вершин, пути spt(w) и поиск до цели.
+template <class Queue, class G> static bool sptDijkstra(const G& g, size_t s, const vector<double>& d) {
+    SptDijkstra_T<G, Queue> spt(g, s);
+    for (size_t w = 0; w < g.size(); w++) {
+        if (spt.distance(w) != d[w]) return false;
+        if (d[w] != INF && w != s && !validPath(g, spt.spt(w), s, w, d)) return false;
+    }
+    return true;
+}
+
+template <class G> static bool sptDijkstra(mt19937& rnd) {
+    for (int i = 0; i < 200; i++) {
+        const size_t n = 1 + rnd() % 60;
+        auto g = randomGraph<G>(rnd, n, rnd() % (3 * n + 1));
+        const size_t s = rnd() % n;
+        auto d = bellmanFord(g, s);
+        bool ok = sptDijkstra<LazyQueue_T<double>>(g, s, d) && sptDijkstra<DaryHeap_T<double, 2>>(g, s, d);
+        ok &= sptDijkstra<DaryHeap_T<double, 4>>(g, s, d) && sptDijkstra<DaryHeap_T<double, 8>>(g, s, d);
+        ok &= sptDijkstra<PairingHeap_T<double>>(g, s, d) && sptDijkstra<RadixHeap_T<double>>(g, s, d);
+        if (!ok) return false;
+        // Поиск до достижимой цели.
+        const size_t t = rnd() % n;
+        if (d[t] != INF && SptDijkstra_T<G>(g, s, t).distance() != d[t]) return false;
+    }
+    return true;
+}
+
+// Один движок DijkstraEngine_T с очередью Queue на серию запросов. Эталон - SptDijkstra_T из каждого источника.
+// queryAll() - расстояния, settled() и spt(w) всех вершин; query() - в том числе s == t и недостижимые цели;
+// queryRadius() - ровно вершины в пределах радиуса в порядке возрастания расстояния.
+template <class Queue, class G> static bool dijkstraEngine(mt19937& rnd, const G& g) {
+    const size_t n = g.size();
+    DijkstraEngine_T<G, Queue> engine(g);
+    for (int q = 0; q < 10; q++) {
+        const size_t s = rnd() % n;
+        SptDijkstra_T<G> spt(g, s);
+        vector<double> d(n);
+        for (size_t v = 0; v < n; v++) d[v] = spt.distance(v);
+
+        engine.queryAll(s);
+        if (engine.source() != s || engine.source(s) != -1) return false;
+        size_t reachable = 0;
+        for (size_t w = 0; w < n; w++) {
+            reachable += d[w] != INF;
+            if (engine.distance(w) != d[w] || engine.settled(w) != (d[w] != INF)) return false;
+            if (d[w] != INF ? !validPath(g, engine.spt(w), s, w, d) : !engine.spt(w).empty()) return false;
+        }
+        if (engine.settledVertices().size() != reachable) return false;
+
+        const size_t t = q == 0 ? s : rnd() % n;
+        if (engine.query(s, t) != d[t]) return false;
+        if (d[t] != INF ? !validPath(g, engine.spt(t), s, t, d) : !engine.spt(t).empty()) return false;
+
+        const double radius = rnd() % 30;
+        const auto& ball = engine.queryRadius(s, radius);
+        size_t inside = 0;
+        for (size_t w = 0; w < n; w++) inside += d[w] <= radius;
+        if (ball.size() != inside) return false;
+        for (size_t i = 0; i < ball.size(); i++) {
+            const size_t w = ball[i];
+            if (d[w] > radius || engine.distance(w) != d[w] || !validPath(g, engine.spt(w), s, w, d)) return false;
+            if (i > 0 && d[ball[i - 1]] > d[w]) return false;
+        }
+    }
+    return true;
+}
+
+template <class G> static bool dijkstraEngine(mt19937& rnd) {
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 1 + rnd() % 60;
+        auto g = randomGraph<G>(rnd, n, rnd() % (2 * n + 1));
+        bool ok = dijkstraEngine<LazyQueue_T<double>>(rnd, g) && dijkstraEngine<DaryHeap_T<double, 2>>(rnd, g);
+        ok &= dijkstraEngine<DaryHeap_T<double, 4>>(rnd, g) && dijkstraEngine<DaryHeap_T<double, 8>>(rnd, g);
+        ok &= dijkstraEngine<PairingHeap_T<double>>(rnd, g) && dijkstraEngine<RadixHeap_T<double>>(rnd, g);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Один BiDijkstra_T с очередью Queue на серию запросов s-t, включая s == t и недостижимые t.
+// Длина совпадает с SptDijkstra_T, path() - путь из рёбер графа от s к t с накопленными весами, пустой при s == t и без пути.
+template <class Queue, class G> static bool biDijkstra(mt19937& rnd, const G& g) {
+    const size_t n = g.size();
+    BiDijkstra_T<G, Queue> bi(g);
+    for (int q = 0; q < 20; q++) {
+        const size_t s = rnd() % n, t = q == 0 ? s : rnd() % n;
+        SptDijkstra_T<G> spt(g, s);
+        vector<double> d(n);
+        for (size_t v = 0; v < n; v++) d[v] = spt.distance(v);
+        if (bi.query(s, t) != d[t] || bi.distance() != d[t]) return false;
+        if (d[t] == INF || s == t ? !bi.path().empty() : !validPath(g, bi.path(), s, t, d)) return false;
+    }
+    return true;
+}
+
+template <class G> static bool biDijkstra(mt19937& rnd) {
+    for (int i = 0; i < 100; i++) {
+        const size_t n = 1 + rnd() % 60;
+        auto g = randomGraph<G>(rnd, n, rnd() % (2 * n + 1));
+        bool ok = biDijkstra<LazyQueue_T<double>>(rnd, g) && biDijkstra<DaryHeap_T<double, 2>>(rnd, g);
+        ok &= biDijkstra<DaryHeap_T<double, 4>>(rnd, g) && biDijkstra<DaryHeap_T<double, 8>>(rnd, g);
+        ok &= biDijkstra<PairingHeap_T<double>>(rnd, g) && biDijkstra<RadixHeap_T<double>>(rnd, g);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void sptTest()
+{
+    mt19937 rnd(48);
+    report("SptDijkstra_T", sptDijkstra<SparseGraphW>(rnd));
+    report("SptDijkstra_T directed", sptDijkstra<SparseGraphWD>(rnd));
+    report("DijkstraEngine_T", dijkstraEngine<SparseGraphW>(rnd));
+    report("DijkstraEngine_T directed", dijkstraEngine<SparseGraphWD>(rnd));
+    report("BiDijkstra_T", biDijkstra<SparseGraphW>(rnd));
+    report("BiDijkstra_T directed", biDijkstra<SparseGraphWD>(rnd));
+}
+
+void sptBenchmark()
+{
+    mt19937 rnd(1);
+
+    SparseGraphW road(500 * 500);
+    roadGraph(road, 500, 500, rnd);
+    sptBenchmark("Road grid", road, rnd);
+    sptQueriesBenchmark(road, 500, 500, rnd);
+    biDijkstraBenchmark(road, rnd);
+
+    SparseGraphW social(200000);
+    socialGraph(social, 8, rnd);
+    sptBenchmark("Social graph", social, rnd);
+}
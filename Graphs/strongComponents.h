@@ -11,7 +11,12 @@
 
 #include <vector>
 #include <stack>
+#include <memory>
+#include <cstdint>
 #include "graphBase.h"
+#include "searchGraph.h"
+#include "denseGraph.h"
+#include "csrGraph.h"
 #include "debug.h"
 
 using namespace std;
@@ -69,6 +74,85 @@ namespace Graph {
         bool connected( size_t v, size_t w ) const { return ids[v] == ids[w]; }
     };
     
+    // Сильные компоненты. Специализация CC_T для ориентированных графов на списках смежности (SparseGraph_T, CSRGraph_T).
+    // Алгоритм Косарайю - Шарира.
+    // Вместо построения обращённого графа вставкой рёбер - однократное транспонирование подсчётом в плоский буфер
+    // CSRGraph_T с 32-битными номерами вершин: V * 8 + E * 4 байт.
+    // 1. Итеративный DFS по транспонированному графу даёт порядок выхода из вершин.
+    // 2. Вершины графа в обратном порядке выхода - корни компонент: всё непомеченное достижимое из корня - его компонента.
+    //    Порядок обхода внутри компоненты не важен, поэтому достаточно стека вершин.
+    // Рекурсии нет, глубина пути ограничена только памятью. Номера компонент - в обратном топологическом порядке.
+    template <class G, class C> class CC_T<G, C,
+        typename enable_if<!is_same<G, DenseGraph_T<C>>::value &&
+        is_base_of<DirectedGraphTraits, C>::value>::type> {
+        
+        using Index = uint32_t;
+        size_t cnt = 0;
+        size_t scnt = 0;
+        vector<size_t> ids;
+		
+        friend void SCTrace<CC_T>(ostream&, const CC_T&);
+        
+    public:
+        CC_T( const G& g ) : ids(g.size(), -1) { trace("CC_T Kosaraju CSR transpose");
+            assert(g.size() < Index(-1));
+            vector<Index> leave;
+            leave.reserve(g.size());
+            {
+                // Транспонированный граф нужен только для первого прохода.
+                const CSRGraph_T<DirectedGraphTraits, Index> r(g, true);
+                struct Frame {
+                    Index v;
+                    size_t next; // Следующее ребро.
+                };
+                vector<Frame> st;
+                for ( size_t s = 0; s < r.size(); s++ ) {
+                    if ( ids[s] != -1 ) continue;
+                    ids[s] = 0;
+                    st.push_back({Index(s), 0});
+                    while ( !st.empty() ) {
+                        Frame& f = st.back();
+                        auto adj = r.adjacent(f.v);
+                        if ( f.next < adj.size() ) {
+                            size_t w = adj[f.next++];
+                            if ( ids[w] == -1 ) {
+                                ids[w] = 0;
+                                st.push_back({Index(w), 0});
+                            }
+                        } else {
+                            leave.push_back(f.v);
+                            st.pop_back();
+                        }
+                    }
+                }
+            }
+            cnt = leave.size();
+
+            ids.assign(g.size(), -1);
+            vector<Index> st;
+            for ( size_t i = leave.size(); i-- > 0; ) {
+                size_t root = leave[i];
+                if ( ids[root] != -1 ) continue;
+                ids[root] = scnt;
+                st.push_back(Index(root));
+                while ( !st.empty() ) {
+                    size_t v = st.back(); st.pop_back();
+                    for ( size_t w : g.adjacent(v) ) {
+                        if ( ids[w] == -1 ) {
+                            ids[w] = scnt;
+                            st.push_back(Index(w));
+                        }
+                    }
+                }
+                scnt++;
+            }
+        }
+        
+        size_t size() const { return scnt; }
+		size_t id(size_t v) const { return ids[v]; }
+        bool connected( size_t v, size_t w ) const { return ids[v] == ids[w]; }
+    };
+    
     // Сильные компоненты. Специализация CC_T для графа на матрице смежности. Алгоритм Косарайю.
     // Вместо транспонирования графа применяем обращение к транспонированной матрице смежности.
     template <class G, class C> class CC_T<G, C,
@@ -217,6 +301,226 @@ namespace Graph {
     
     // Ускоритель вызова.
     template<class G> SCGab_T<G> SCGab(const G& g) { return SCGab_T<G>(g); }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Экономные итеративные варианты Тарьяна и Габова для очень больших графов (V < 2^32).
+    // Всё состояние вершины - одно 32-битное слово r[v]:
+    // 0 - не посещена; меньше index - посещена и ещё не в компоненте (номер входа); не меньше index - номер компоненты.
+    // Номера входа переиспользуются (Pearce 2016): после выделения компоненты index уменьшается до количества
+    // посещённых вершин вне компонент, а номера компонент раздаются сверху вниз от V. Поэтому их диапазоны не пересекаются
+    // и отдельные флаги "в стеке" и "в компоненте" не нужны. В конце r[v] переводится в номер компоненты
+    // в обратном топологическом порядке, как у SCTar_T.
+    // Стеки - заранее выделенные массивы по V слов, позиция обхода списка смежности - в массиве next.
+    // Рекурсии нет. Нужен список смежности с доступом по индексу: SparseGraph_T, CSRGraph_T.
+    // Буферы сохраняются: solve() пересчитывает компоненты изменившегося графа без новых выделений памяти.
+    template <class G> class SCLeanBase_T {
+    protected:
+        using Index = uint32_t;
+
+        const G& g;
+        size_t cnt; // количество вершин.
+        size_t scnt; // количество сильных компонент.
+        vector<Index> ids; // r[v] во время solve().
+        vector<Index> next; // Следующее ребро вершины на пути обхода.
+        vector<Index> st; // Стек вершин компонент.
+        Index index; // Следующий номер входа.
+        Index comp; // Следующий номер компоненты.
+
+        SCLeanBase_T( const G& g ) : g(g) {}
+
+        void init_() {
+            assert(g.size() < Index(-1));
+            cnt = g.size();
+            scnt = 0;
+            ids.assign(cnt, 0);
+            next.resize(cnt);
+            st.resize(cnt);
+            index = 1;
+            comp = Index(cnt);
+        }
+
+        // Номера компонент от V вниз в номера от 0 в порядке нахождения.
+        void finish_() {
+            scnt = cnt - comp;
+            for ( size_t v = 0; v < cnt; v++ ) ids[v] = Index(cnt) - ids[v];
+        }
+
+    public:
+        size_t size() const { return scnt; }
+		size_t id(size_t v) const { return ids[v]; }
+        bool connected( size_t v, size_t w ) const { return ids[v] == ids[w]; }
+
+        // Рабочая память в байтах.
+        size_t memory() const { return (ids.capacity() + next.capacity() + st.capacity()) * sizeof(Index); }
+    };
+
+    // Тарьян в варианте Pearce: вместо enter и low одно слово r[v], а пометка корня - старший бит next[v].
+    // Путь обхода и стек компонент не пересекаются, поэтому делят один массив st, растут навстречу друг другу.
+    // Память 12 * V байт.
+    template <class G> class SCTarLean_T : public SCLeanBase_T<G> {
+        using Base = SCLeanBase_T<G>;
+        using typename Base::Index;
+        using Base::g; using Base::cnt; using Base::ids; using Base::next; using Base::st; using Base::index; using Base::comp;
+        static constexpr Index ROOT = Index(1) << 31;
+
+        friend void SCTrace<SCTarLean_T>(ostream&, const SCTarLean_T&);
+
+    public:
+        SCTarLean_T( const G& g ) : Base(g) { trace("SCTarLean_T"); solve(); }
+
+        void solve() {
+            this->init_();
+            size_t path = 0; // Путь - st[0, path).
+            size_t top = cnt; // Стек компонент - st[top, cnt).
+            for ( size_t s = 0; s < cnt; s++ ) {
+                if ( ids[s] != 0 ) continue;
+                ids[s] = index++;
+                next[s] = ROOT;
+                st[path++] = Index(s);
+                while ( path > 0 ) {
+                    Index v = st[path - 1];
+                    const auto& adj = g.adjacent(v);
+                    size_t i = next[v] & ~ROOT;
+                    if ( i < adj.size() ) {
+                        size_t w = adj[i];
+                        next[v]++;
+                        if ( ids[w] == 0 ) {
+                            ids[w] = index++;
+                            next[w] = ROOT;
+                            st[path++] = Index(w);
+                        } else if ( ids[w] < ids[v] ) {
+                            ids[v] = ids[w];
+                            next[v] &= ~ROOT;
+                        }
+                        continue;
+                    }
+                    path--;
+                    if ( next[v] & ROOT ) {
+                        // Нашли сильную компоненту: v и вершины стека с номерами входа не меньше r[v].
+                        index--;
+                        while ( top < cnt && ids[v] <= ids[st[top]] ) {
+                            ids[st[top++]] = comp;
+                            index--;
+                        }
+                        ids[v] = comp--;
+                    } else {
+                        st[--top] = v;
+                    }
+                    if ( path > 0 ) {
+                        Index u = st[path - 1];
+                        if ( ids[v] < ids[u] ) {
+                            ids[u] = ids[v];
+                            next[u] &= ~ROOT;
+                        }
+                    }
+                }
+            }
+            this->finish_();
+        }
+    };
+
+    // Ускоритель вызова.
+    template<class G> SCTarLean_T<G> SCTarLean(const G& g) { return SCTarLean_T<G>(g); }
+
+    // Габов: r[v] - номер входа, стек компонент st, стек корней path и путь обхода dfs.
+    // Память 20 * V байт.
+    template <class G> class SCGabLean_T : public SCLeanBase_T<G> {
+        using Base = SCLeanBase_T<G>;
+        using typename Base::Index;
+        using Base::g; using Base::cnt; using Base::ids; using Base::next; using Base::st; using Base::index; using Base::comp;
+        vector<Index> path, dfs;
+
+        friend void SCTrace<SCGabLean_T>(ostream&, const SCGabLean_T&);
+
+    public:
+        SCGabLean_T( const G& g ) : Base(g) { trace("SCGabLean_T"); solve(); }
+
+        void solve() {
+            this->init_();
+            path.resize(cnt);
+            dfs.resize(cnt);
+            size_t top = 0, ptop = 0, dtop = 0;
+            for ( size_t s = 0; s < cnt; s++ ) {
+                if ( ids[s] != 0 ) continue;
+                ids[s] = index++;
+                next[s] = 0;
+                st[top++] = path[ptop++] = dfs[dtop++] = Index(s);
+                while ( dtop > 0 ) {
+                    Index v = dfs[dtop - 1];
+                    const auto& adj = g.adjacent(v);
+                    if ( next[v] < adj.size() ) {
+                        size_t w = adj[next[v]++];
+                        if ( ids[w] == 0 ) {
+                            ids[w] = index++;
+                            next[w] = 0;
+                            st[top++] = path[ptop++] = dfs[dtop++] = Index(w);
+                        } else if ( ids[w] < index ) {
+                            // Цикл. Сжимаем путь до w.
+                            while ( ids[path[ptop - 1]] > ids[w] ) ptop--;
+                        }
+                        continue;
+                    }
+                    dtop--;
+                    if ( path[ptop - 1] == v ) {
+                        // Нашли сильную компоненту. Номера входа её вершин освобождаются.
+                        ptop--;
+                        index = ids[v];
+                        Index w;
+                        do {
+                            w = st[--top];
+                            ids[w] = comp;
+                        } while ( w != v );
+                        comp--;
+                    }
+                }
+            }
+            this->finish_();
+        }
+
+        size_t memory() const { return Base::memory() + (path.capacity() + dfs.capacity()) * sizeof(Index); }
+    };
+
+    // Ускоритель вызова.
+    template<class G> SCGabLean_T<G> SCGabLean(const G& g) { return SCGabLean_T<G>(g); }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Конденсация - базовый DAG сильных компонент. Седжвик 19.13.
+    // Строится сразу в CSR: рёбра между компонентами сортируются, повторяющиеся удаляются. Память O(V + E) вместо
+    // O(V^2) у DenseDAG. SC - алгоритм сильных компонент с интерфейсом size(), id(v), connected(v, w).
+    // Tarjan и Gabow нумеруют компоненты в обратном топологическом порядке: рёбра DAG идут от больших номеров к меньшим.
+    // DAG разделяемый: индексы достижимости над одной конденсацией не копируют её.
+    template <class G, class SC = SCGab_T<G>> class Condensation_T {
+    public:
+        using DAG = CSRGraph_T<DAGTraits, uint32_t>;
+
+    private:
+        SC _sc;
+        shared_ptr<const DAG> _dag;
+
+        static shared_ptr<const DAG> build_(const G& g, const SC& sc) {
+            vector<typename DAG::Edge> edges;
+            for (size_t v = 0; v < g.size(); v++) {
+                for (size_t w : g.adjacent(v)) {
+                    if (!sc.connected(v, w)) edges.push_back({sc.id(v), sc.id(w)});
+                }
+            }
+            return make_shared<const DAG>(sc.size(), std::move(edges));
+        }
+
+    public:
+        Condensation_T(const G& g) : _sc(g), _dag(build_(g, _sc)) { trace("Condensation_T"); }
+
+        // Количество сильных компонент - вершин DAG.
+        size_t size() const { return _sc.size(); }
+        size_t id(size_t v) const { return _sc.id(v); }
+        bool connected(size_t v, size_t w) const { return _sc.connected(v, w); }
+
+        const SC& sc() const { return _sc; }
+        const DAG& dag() const { return *_dag; }
+        const shared_ptr<const DAG>& sharedDag() const { return _dag; }
+    };
 }
 
+void scTest();
+
 #endif /* strongComponents_h */
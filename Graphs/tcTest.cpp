@@ -0,0 +1,72 @@
+//
+//  tcTest.cpp
+//  Graphs
+//
+//  Created by Oleg Bakharev on 18/10/2026.
+//  Copyright © 2026 Oleg Bakharev. All rights reserved.
+//
+// Сравнение алгоритмов транзитивного замыкания на одних и тех же графах.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "sparseGraph.h"
+#include "graphGen.h"
+#include "directedGraph.h"
+#include "dag.h"
+
+using namespace std;
+using namespace Graph;
+
+// Время построения замыкания в секундах. Замыкание возвращается для сверки.
+template <class TC, class G> static TC measure(const char* name, const G& g, double& seconds) {
+    auto start = chrono::steady_clock::now();
+    TC tc(g);
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << setw(20) << name << setw(12) << fixed << setprecision(4) << seconds << " s\n";
+    return tc;
+}
+
+template <class TC1, class TC2> static bool same(const TC1& a, const TC2& b, size_t n) {
+    for (size_t v = 0; v < n; v++)
+        for (size_t w = 0; w < n; w++)
+            if (a.reachable(v, w) != b.reachable(v, w)) return false;
+    return true;
+}
+
+template <class G> static void tcBenchmark(const char* title, const G& g) {
+    cout << "\n" << title << ": V = " << g.size() << ", E = " << g.edgesCount() << "\n";
+    double t;
+    auto w = measure<TCW>("Warshall", g, t);
+    auto fr = measure<TCFR>("Four Russians", g, t);
+    cout << setw(20) << "squarings" << setw(12) << fr.iterations() << "\n";
+    auto dfs = measure<TC_T<G>>(is_same<typename G::Traits, DAGTraits>::value ? "DFS DAG" : "DFS", g, t);
+    auto par = measure<TCPar_T<G>>("Parallel DFS", g, t);
+    cout << "Equal: " << boolalpha << (same(w, fr, g.size()) && same(w, dfs, g.size()) && same(w, par, g.size())) << "\n";
+}
+
+void tcBenchmark()
+{
+    const size_t n = 2000;
+
+    // Случайный орграф: почти все вершины в одной сильной компоненте малого диаметра.
+    SparseGraphD g(n);
+    randE(g, 4 * n);
+    tcBenchmark("Random digraph", g);
+
+    // Случайный DAG: рёбра только от больших вершин к меньшим.
+    SparseDAG dag(n);
+    randG(dag, 4 * n);
+    tcBenchmark("Random DAG", dag);
+    auto start = chrono::steady_clock::now();
+    auto tr = TR(dag);
+    cout << setw(20) << "Reduction" << setw(12) << fixed << setprecision(4)
+        << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s, edges "
+        << dag.edgesCount() << " -> " << tr.getTR().edgesCount() << "\n";
+    cout << "Equal: " << boolalpha << (TCW(dag).bits() == TCW(tr.getTR()).bits()) << "\n";
+    SparseGraphD dagD(n);
+    for (size_t v = 0; v < n; v++)
+        for (size_t w : dag.adjacent(v)) dagD.insert({v, w});
+    tcBenchmark("Random DAG as digraph", dagD);
+}